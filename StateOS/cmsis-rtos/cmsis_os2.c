@@ -54,6 +54,10 @@
 #include <string.h>
 #include "oscmsis.h"
 
+#if     OS_PRIO_LEVELS && OS_PRIO_LEVELS <= 56 /* osPriorityISR is an enumerator, it cannot be used by the preprocessor */
+#error  osconfig.h: Incorrect OS_PRIO_LEVELS value! Must be greater then osPriorityISR (56).
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 osStatus_t osKernelInitialize (void)
@@ -81,7 +85,7 @@ osStatus_t osKernelGetInfo (osVersion_t *version, char *id_buf, uint32_t id_size
 
 osKernelState_t osKernelGetState (void)
 {
-	return osKernelRunning;
+	return System.lock ? osKernelLocked : osKernelRunning;
 }
 
 osStatus_t osKernelStart (void)
@@ -100,8 +104,9 @@ int32_t osKernelLock (void)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	lock = port_get_lock();
-	port_set_lock();
+	lock = System.lock ? 1 : 0;
+	if (!lock)
+		tsk_lock();
 	return lock;
 }
 
@@ -112,8 +117,9 @@ int32_t osKernelUnlock (void)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	lock = port_get_lock();
-	port_clr_lock();
+	lock = System.lock ? 1 : 0;
+	if (lock)
+		tsk_unlock();
 	return lock;
 }
 
@@ -122,18 +128,46 @@ int32_t osKernelRestoreLock (int32_t lock)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	port_put_lock(lock);
-	return lock;
+	if (lock && !System.lock)
+		tsk_lock();
+	else
+	if (!lock && System.lock)
+		tsk_unlock();
+	return lock ? 1 : 0;
 }
 
 uint32_t osKernelSuspend (void)
 {
-	return 0U;
+	cnt_t delay;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return 0U;
+
+	tsk_lock(); // no task switch until osKernelResume, the interrupts stay enabled
+
+	sys_lock();
+	delay = core_sys_suspend();
+	sys_unlock();
+
+	if (delay == INFINITE)
+		return osWaitForever;
+#if OS_TIMER_SIZE == 64
+	if (delay > osWaitForever)
+		return osWaitForever;
+#endif
+	return (uint32_t)delay;
 }
 
 void osKernelResume (uint32_t sleep_ticks)
 {
-	(void) sleep_ticks;
+	if (IS_IRQ_MODE())
+		return;
+
+	sys_lock();
+	core_sys_resume((cnt_t)sleep_ticks);
+	sys_unlock();
+
+	tsk_unlock(); // the tasks woken up by the timers or interrupts are switched here
 }
 
 uint32_t osKernelGetTickCount (void)
@@ -448,10 +482,14 @@ uint32_t osThreadGetStackSpace (osThreadId_t thread_id)
 	if (&thread->tsk == &MAIN)
 		return 0U;
 
+#if OS_STACK_PAINT
+	return osThreadGetStackSize(thread_id) - tsk_stackUsage(&thread->tsk);
+#else
 	if (&thread->tsk != tsk_this())
 		return (uint32_t) thread->tsk.sp - (uint32_t) thread->tsk.stack;
 
 	return (uint32_t) port_get_sp() - (uint32_t) thread->tsk.stack;
+#endif
 }
 
 uint32_t osThreadGetCount (void)
@@ -470,7 +508,7 @@ uint32_t osThreadGetCount (void)
 	for (tsk = IDLE.obj.next; tsk != &IDLE; tsk = tsk->obj.next)
 		count++;
 
-	for (tmr = WAIT.obj.next; tmr != &WAIT; tmr = tmr->obj.next)
+	for (tmr = core_tmr_next(&WAIT); tmr != &WAIT; tmr = core_tmr_next(tmr))
 		if (tmr->id == ID_DELAYED)
 			count++;
 
@@ -495,7 +533,7 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items)
 	for (tsk = IDLE.obj.next; (tsk != &IDLE) && (count < array_items); tsk = tsk->obj.next)
 		thread_array[count++] = tsk;
 
-	for (tmr = WAIT.obj.next; (tmr != &WAIT) && (count < array_items); tmr = tmr->obj.next)
+	for (tmr = core_tmr_next(&WAIT); (tmr != &WAIT) && (count < array_items); tmr = core_tmr_next(tmr))
 		if (tmr->id == ID_DELAYED)
 			thread_array[count++] = tmr;
 
@@ -504,6 +542,25 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items)
 	return count;
 }
 
+#if OS_TASK_STATS
+
+osStatus_t osThreadGetStats (osThreadId_t thread_id, tst_t *stats)
+{
+	osThread_t *thread = thread_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+
+	if ((thread_id == NULL) || (stats == NULL))
+		return osErrorParameter;
+
+	tsk_getStats(&thread->tsk, stats);
+
+	return osOK;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags)
@@ -1113,7 +1170,7 @@ osStatus_t osMemoryPoolFree (osMemoryPoolId_t mp_id, void *block)
 {
 	osMemoryPool_t *mp = mp_id;
 
-	if (mp_id == NULL)
+	if (mp_id == NULL || !mem_owns(&mp->mem, block))
 		return osErrorParameter;
 
 	mem_give(&mp->mem, block);
@@ -1144,37 +1201,21 @@ uint32_t osMemoryPoolGetBlockSize (osMemoryPoolId_t mp_id)
 uint32_t osMemoryPoolGetCount (osMemoryPoolId_t mp_id)
 {
 	osMemoryPool_t *mp = mp_id;
-	uint32_t     count = mp->mem.limit;
-	que_t         *que;
 
 	if (mp_id == NULL)
 		return 0U;
 
-	sys_lock();
-
-	for (que = mp->mem.head.next; que != NULL; que = que->next) count--;
-
-	sys_unlock();
-
-	return count;
+	return mp->mem.limit - mem_space(&mp->mem);
 }
 
 uint32_t osMemoryPoolGetSpace (osMemoryPoolId_t mp_id)
 {
 	osMemoryPool_t *mp = mp_id;
-	uint32_t     count = 0;
-	que_t        *que;
 
 	if (mp_id == NULL)
 		return 0U;
 
-	sys_lock();
-
-	for (que = mp->mem.head.next; que != NULL; que = que->next) count++;
-
-	sys_unlock();
-
-	return count;
+	return mem_space(&mp->mem);
 }
 
 osStatus_t osMemoryPoolDelete (osMemoryPoolId_t mp_id)
@@ -1244,10 +1285,10 @@ osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, con
 
 	sys_lock();
 
-	box_init(&mq->box, msg_count, data, msg_size);
-	if (attr->cb_mem == NULL || attr->cb_size == 0U) mq->box.res = mq;
+	pbx_init(&mq->pbx, msg_count, data, msg_size);
+	if (attr->cb_mem == NULL || attr->cb_size == 0U) mq->pbx.res = mq;
 	else
-	if (attr->mq_mem == NULL || attr->mq_size == 0U) mq->box.res = data;
+	if (attr->mq_mem == NULL || attr->mq_size == 0U) mq->pbx.res = data;
 	mq->flags = flags;
 	mq->name = (attr == NULL) ? NULL : attr->name;
 
@@ -1270,15 +1311,13 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
 {
 	osMessageQueue_t *mq = mq_id;
 
-	(void)msg_prio; /* message priority is ignored */
-
 	if ((mq_id == NULL) || (msg_ptr == NULL))
 		return osErrorParameter;
 
 	if ((IS_IRQ_MODE() || IS_IRQ_MASKED()) && (timeout != 0U))
 		return osErrorParameter;
 
-	switch (box_sendFor(&mq->box, msg_ptr, timeout))
+	switch (pbx_sendFor(&mq->pbx, msg_ptr, msg_prio, timeout))
 	{
 		case E_SUCCESS: return osOK;
 		case E_TIMEOUT: return osErrorTimeout;
@@ -1289,8 +1328,7 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
 osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
 {
 	osMessageQueue_t *mq = mq_id;
-
-	(void)msg_prio; /* message priority is ignored */
+	unsigned          prio;
 
 	if ((mq_id == NULL) || (msg_ptr == NULL))
 		return osErrorParameter;
@@ -1298,9 +1336,10 @@ osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *
 	if ((IS_IRQ_MODE() || IS_IRQ_MASKED()) && (timeout != 0U))
 		return osErrorParameter;
 
-	switch (box_waitFor(&mq->box, msg_ptr, timeout))
+	switch (pbx_waitFor(&mq->pbx, msg_ptr, &prio, timeout))
 	{
-		case E_SUCCESS: return osOK;
+		case E_SUCCESS: if (msg_prio != NULL) *msg_prio = (uint8_t)prio;
+		                return osOK;
 		case E_TIMEOUT: return osErrorTimeout;
 		default:        return osErrorResource;
 	}
@@ -1313,7 +1352,7 @@ uint32_t osMessageQueueGetCapacity (osMessageQueueId_t mq_id)
 	if (mq_id == NULL)
 		return 0U;
 
-	return mq->box.limit;
+	return mq->pbx.limit;
 }
 
 uint32_t osMessageQueueGetMsgSize (osMessageQueueId_t mq_id)
@@ -1323,7 +1362,7 @@ uint32_t osMessageQueueGetMsgSize (osMessageQueueId_t mq_id)
 	if (mq_id == NULL)
 		return 0U;
 
-	return mq->box.size;
+	return mq->pbx.size;
 }
 
 uint32_t osMessageQueueGetCount (osMessageQueueId_t mq_id)
@@ -1333,24 +1372,17 @@ uint32_t osMessageQueueGetCount (osMessageQueueId_t mq_id)
 	if (mq_id == NULL)
 		return 0U;
 
-	return mq->box.count;
+	return pbx_count(&mq->pbx);
 }
 
 uint32_t osMessageQueueGetSpace (osMessageQueueId_t mq_id)
 {
 	osMessageQueue_t *mq = mq_id;
-	uint32_t       count;
 
 	if (mq_id == NULL)
 		return 0U;
 
-	sys_lock();
-
-	count = mq->box.limit - mq->box.count;
-
-	sys_unlock();
-
-	return count;
+	return pbx_space(&mq->pbx);
 }
 
 osStatus_t osMessageQueueReset (osMessageQueueId_t mq_id)
@@ -1362,7 +1394,7 @@ osStatus_t osMessageQueueReset (osMessageQueueId_t mq_id)
 	if (mq_id == NULL)
 		return osErrorParameter;
 
-	box_kill(&mq->box);
+	pbx_kill(&mq->pbx);
 
 	return osOK;
 }
@@ -1376,7 +1408,7 @@ osStatus_t osMessageQueueDelete (osMessageQueueId_t mq_id)
 	if (mq_id == NULL)
 		return osErrorParameter;
 
-	box_delete(&mq->box);
+	pbx_delete(&mq->pbx);
 
 	return osOK;
 }
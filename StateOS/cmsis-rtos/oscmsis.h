@@ -68,6 +68,14 @@ typedef struct __Thread osThread_t;
 #define osThreadCbSize sizeof(osThread_t)
 #define osThreadStackSize(size) (((((size)?(size):(OS_STACK_SIZE))+7)/8)*8)
 
+#if OS_TASK_STATS
+/// Get run-time statistics of a thread (StateOS extension).
+/// \param[in]     thread_id     thread ID obtained by \ref osThreadNew, \ref osThreadGetId or \ref osThreadEnumerate.
+/// \param[out]    stats         pointer to structure for retrieving run time, context switches, preemptions and voluntary yields.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osThreadGetStats (osThreadId_t thread_id, tst_t *stats);
+#endif
+
 /*---------------------------------------------------------------------------*/
 
 struct __Timer
@@ -134,13 +142,13 @@ struct __MemoryPool
 typedef struct __MemoryPool osMemoryPool_t;
 
 #define osMemoryPoolCbSize sizeof(osMemoryPool_t)
-#define osMemoryPoolMemSize(count, size) ((((((size)+3)/4)+1)*4)*count)
+#define osMemoryPoolMemSize(count, size) ((((((size)+3)/4)+MHEAD)*4)*count)
 
 /*---------------------------------------------------------------------------*/
 
 struct __MessageQueue
 {
-	box_t        box;   // StateOS mail box object
+	pbx_t        pbx;   // StateOS priority mailbox queue object
 	uint32_t     flags; // attribute bits
 	const char * name;  // mail box name
 };
@@ -148,7 +156,7 @@ struct __MessageQueue
 typedef struct __MessageQueue osMessageQueue_t;
 
 #define osMessageQueueCbSize sizeof(osMessageQueue_t)
-#define osMessageQueueMemSize(count, size) (((((size)+3)/4)*4)*count)
+#define osMessageQueueMemSize(count, size) ((((((size)+3)/4)+PHEAD)*4)*count)
 
 /* -------------------------------------------------------------------------- */
 
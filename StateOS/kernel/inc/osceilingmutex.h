@@ -0,0 +1,383 @@
+/******************************************************************************
+
+    @file    StateOS: osceilingmutex.h
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_PCM_H
+#define __STATEOS_PCM_H
+
+#include "oskernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : priority ceiling mutex (non-recursive, immediate priority ceiling, robust)
+ *
+ * Note              : the owner runs at the ceiling priority as long as it holds the mutex,
+ *                     so no task using the mutex can preempt the owner and no blocking chains are formed;
+ *                     the ceiling must not be lower than the basic priority of any task using the mutex,
+ *                     nested priority ceiling mutexes must be unlocked in the reverse order of locking;
+ *                     lock and unlock do not search any list of the ceiling mutexes, they change the priority
+ *                     with core_tsk_prio / core_cur_prio, which check the mutexes with priority inheritance held by the owner
+ *                     (none if the owner uses only priority ceiling mutexes) and reorder the READY queue
+ *                     (in a constant time when OS_PRIO_LEVELS is set)
+ *
+ ******************************************************************************/
+
+typedef struct __pcm pcm_t, * const pcm_id;
+
+struct __pcm
+{
+	tsk_t  * queue;   // next process in the DELAYED queue
+	void   * res;     // allocated priority ceiling mutex object's resource
+	tsk_t  * owner;   // owner task
+	unsigned ceiling; // priority ceiling
+	unsigned prio;    // basic priority of the owner task before locking
+	pcm_t  * list;    // priority ceiling mutex locked previously by the owner task
+};
+
+/******************************************************************************
+ *
+ * Name              : _PCM_INIT
+ *
+ * Description       : create and initialize a priority ceiling mutex object
+ *
+ * Parameters
+ *   ceiling         : priority ceiling
+ *
+ * Return            : priority ceiling mutex object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _PCM_INIT( _ceiling ) { 0, 0, 0, _ceiling, 0, 0 }
+
+/******************************************************************************
+ *
+ * Name              : OS_PCM
+ *
+ * Description       : define and initialize a priority ceiling mutex object
+ *
+ * Parameters
+ *   pcm             : name of a pointer to priority ceiling mutex object
+ *   ceiling         : priority ceiling
+ *
+ ******************************************************************************/
+
+#define             OS_PCM( pcm, ceiling )                     \
+                       pcm_t pcm##__pcm = _PCM_INIT( ceiling ); \
+                       pcm_id pcm = & pcm##__pcm
+
+/******************************************************************************
+ *
+ * Name              : static_PCM
+ *
+ * Description       : define and initialize a static priority ceiling mutex object
+ *
+ * Parameters
+ *   pcm             : name of a pointer to priority ceiling mutex object
+ *   ceiling         : priority ceiling
+ *
+ ******************************************************************************/
+
+#define         static_PCM( pcm, ceiling )                     \
+                static pcm_t pcm##__pcm = _PCM_INIT( ceiling ); \
+                static pcm_id pcm = & pcm##__pcm
+
+/******************************************************************************
+ *
+ * Name              : PCM_INIT
+ *
+ * Description       : create and initialize a priority ceiling mutex object
+ *
+ * Parameters
+ *   ceiling         : priority ceiling
+ *
+ * Return            : priority ceiling mutex object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                PCM_INIT( ceiling ) \
+                      _PCM_INIT( ceiling )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : PCM_CREATE
+ * Alias             : PCM_NEW
+ *
+ * Description       : create and initialize a priority ceiling mutex object
+ *
+ * Parameters
+ *   ceiling         : priority ceiling
+ *
+ * Return            : pointer to priority ceiling mutex object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                PCM_CREATE( ceiling ) \
+             & (pcm_t) PCM_INIT  ( ceiling )
+#define                PCM_NEW \
+                       PCM_CREATE
+#endif
+
+/******************************************************************************
+ *
+ * Name              : pcm_init
+ *
+ * Description       : initialize a priority ceiling mutex object
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *   ceiling         : priority ceiling
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pcm_init( pcm_t *pcm, unsigned ceiling );
+
+/******************************************************************************
+ *
+ * Name              : pcm_create
+ * Alias             : pcm_new
+ *
+ * Description       : create and initialize a new priority ceiling mutex object
+ *
+ * Parameters
+ *   ceiling         : priority ceiling
+ *
+ * Return            : pointer to priority ceiling mutex object (priority ceiling mutex successfully created)
+ *   0               : priority ceiling mutex not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+pcm_t *pcm_create( unsigned ceiling );
+
+__STATIC_INLINE
+pcm_t *pcm_new( unsigned ceiling ) { return pcm_create(ceiling); }
+
+/******************************************************************************
+ *
+ * Name              : pcm_kill
+ *
+ * Description       : reset the priority ceiling mutex object, restore the priority of the owner task
+ *                     and wake up all waiting tasks with 'E_STOPPED' event value
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pcm_kill( pcm_t *pcm );
+
+/******************************************************************************
+ *
+ * Name              : pcm_delete
+ *
+ * Description       : reset the priority ceiling mutex object and free allocated resource
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pcm_delete( pcm_t *pcm );
+
+/******************************************************************************
+ *
+ * Name              : pcm_waitUntil
+ *
+ * Description       : try to lock the priority ceiling mutex object,
+ *                     wait until given timepoint if the priority ceiling mutex object can't be locked immediately
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : priority ceiling mutex object was successfully locked
+ *   E_STOPPED       : priority ceiling mutex object was killed before the specified timeout expired
+ *   E_TIMEOUT       : priority ceiling mutex object was not locked before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned pcm_waitUntil( pcm_t *pcm, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : pcm_waitFor
+ *
+ * Description       : try to lock the priority ceiling mutex object,
+ *                     wait for given duration of time if the priority ceiling mutex object can't be locked immediately
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *   delay           : duration of time (maximum number of ticks to wait for lock the priority ceiling mutex object)
+ *                     IMMEDIATE: don't wait if the priority ceiling mutex object can't be locked immediately
+ *                     INFINITE:  wait indefinitely until the priority ceiling mutex object has been locked
+ *
+ * Return
+ *   E_SUCCESS       : priority ceiling mutex object was successfully locked
+ *   E_STOPPED       : priority ceiling mutex object was killed before the specified timeout expired
+ *   E_TIMEOUT       : priority ceiling mutex object was not locked before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned pcm_waitFor( pcm_t *pcm, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : pcm_wait
+ *
+ * Description       : try to lock the priority ceiling mutex object,
+ *                     wait indefinitely if the priority ceiling mutex object can't be locked immediately
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *
+ * Return
+ *   E_SUCCESS       : priority ceiling mutex object was successfully locked
+ *   E_STOPPED       : priority ceiling mutex object was killed
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned pcm_wait( pcm_t *pcm ) { return pcm_waitFor(pcm, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : pcm_take
+ *
+ * Description       : try to lock the priority ceiling mutex object,
+ *                     don't wait if the priority ceiling mutex object can't be locked immediately
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *
+ * Return
+ *   E_SUCCESS       : priority ceiling mutex object was successfully locked
+ *   E_TIMEOUT       : priority ceiling mutex object can't be locked immediately
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned pcm_take( pcm_t *pcm ) { return pcm_waitFor(pcm, IMMEDIATE); }
+
+/******************************************************************************
+ *
+ * Name              : pcm_give
+ *
+ * Description       : try to unlock the priority ceiling mutex object (only owner task can unlock priority ceiling mutex object),
+ *                     restore the basic priority the owner task had before locking,
+ *                     don't wait if the priority ceiling mutex object can't be unlocked
+ *
+ * Parameters
+ *   pcm             : pointer to priority ceiling mutex object
+ *
+ * Return
+ *   E_SUCCESS       : priority ceiling mutex object was successfully unlocked
+ *   E_TIMEOUT       : priority ceiling mutex object can't be unlocked
+ *
+ * Note              : use only in thread mode
+ *                     the restored priority is the one recorded when the mutex was locked,
+ *                     so the priority changed with tsk_prio while the mutex is held is lost
+ *
+ ******************************************************************************/
+
+unsigned pcm_give( pcm_t *pcm );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : CeilingMutex
+ *
+ * Description       : create and initialize a priority ceiling mutex object
+ *
+ * Constructor parameters
+ *   ceiling         : priority ceiling
+ *
+ ******************************************************************************/
+
+struct CeilingMutex : public __pcm
+{
+	 explicit
+	 CeilingMutex( const unsigned _ceiling ): __pcm _PCM_INIT(_ceiling) {}
+	~CeilingMutex( void ) { assert(owner == nullptr); }
+
+	void     kill     ( void )         {        pcm_kill     (this);         }
+	unsigned waitUntil( cnt_t _time  ) { return pcm_waitUntil(this, _time);  }
+	unsigned waitFor  ( cnt_t _delay ) { return pcm_waitFor  (this, _delay); }
+	unsigned wait     ( void )         { return pcm_wait     (this);         }
+	unsigned take     ( void )         { return pcm_take     (this);         }
+	unsigned give     ( void )         { return pcm_give     (this);         }
+};
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_PCM_H
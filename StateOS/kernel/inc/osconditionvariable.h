@@ -304,6 +304,8 @@ unsigned cnd_wait( cnd_t *cnd, mtx_t *mtx ) { return cnd_waitFor(cnd, mtx, INFIN
  * Return            : none
  *
  * Note              : may be used both in thread and handler mode
+ *                     if the mutex associated with the waiting task is locked, the task is moved directly to the mutex queue
+ *                     (wait morphing) and is scheduled only when it takes over the mutex
  *
  ******************************************************************************/
 
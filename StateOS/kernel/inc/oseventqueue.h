@@ -338,6 +338,31 @@ unsigned evq_take( evq_t *evq );
 __STATIC_INLINE
 unsigned evq_takeISR( evq_t *evq ) { return evq_take(evq); }
 
+/******************************************************************************
+ *
+ * Name              : evq_takeMany
+ * ISR alias         : evq_takeManyISR
+ *
+ * Description       : try to transfer up to 'count' event data from the event queue object in one critical section,
+ *                     wake up the tasks waiting to send for the released space,
+ *                     don't wait if the event queue object is empty
+ *
+ * Parameters
+ *   evq             : pointer to event queue object
+ *   data            : pointer to store event data
+ *   count           : max number of event data to transfer
+ *
+ * Return            : number of event data transfered from the event queue object (0 if the event queue object is empty)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned evq_takeMany( evq_t *evq, unsigned *data, unsigned count );
+
+__STATIC_INLINE
+unsigned evq_takeManyISR( evq_t *evq, unsigned *data, unsigned count ) { return evq_takeMany(evq, data, count); }
+
 /******************************************************************************
  *
  * Name              : evq_sendUntil
@@ -433,6 +458,31 @@ unsigned evq_give( evq_t *evq, unsigned event );
 __STATIC_INLINE
 unsigned evq_giveISR( evq_t *evq, unsigned event ) { return evq_give(evq, event); }
 
+/******************************************************************************
+ *
+ * Name              : evq_giveMany
+ * ISR alias         : evq_giveManyISR
+ *
+ * Description       : try to transfer up to 'count' event data to the event queue object in one critical section,
+ *                     release the tasks waiting to receive first,
+ *                     don't wait if the event queue object is full
+ *
+ * Parameters
+ *   evq             : pointer to event queue object
+ *   data            : pointer to event data
+ *   count           : number of event data to transfer
+ *
+ * Return            : number of event data transfered to the event queue object (less than 'count' if the event queue object is full)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned evq_giveMany( evq_t *evq, const unsigned *data, unsigned count );
+
+__STATIC_INLINE
+unsigned evq_giveManyISR( evq_t *evq, const unsigned *data, unsigned count ) { return evq_giveMany(evq, data, count); }
+
 /******************************************************************************
  *
  * Name              : evq_push
@@ -492,11 +542,13 @@ struct baseEventQueue : public __evq
 	unsigned wait     ( void )                          { return evq_wait     (this);                 }
 	unsigned take     ( void )                          { return evq_take     (this);                 }
 	unsigned takeISR  ( void )                          { return evq_takeISR  (this);                 }
+	unsigned takeMany (       unsigned *_data, unsigned _count ) { return evq_takeMany (this, _data, _count); }
 	unsigned sendUntil( unsigned _event, cnt_t _time  ) { return evq_sendUntil(this, _event, _time);  }
 	unsigned sendFor  ( unsigned _event, cnt_t _delay ) { return evq_sendFor  (this, _event, _delay); }
 	unsigned send     ( unsigned _event )               { return evq_send     (this, _event);         }
 	unsigned give     ( unsigned _event )               { return evq_give     (this, _event);         }
 	unsigned giveISR  ( unsigned _event )               { return evq_giveISR  (this, _event);         }
+	unsigned giveMany ( const unsigned *_data, unsigned _count ) { return evq_giveMany (this, _data, _count); }
 	unsigned push     ( unsigned _event )               { return evq_push     (this, _event);         }
 	unsigned pushISR  ( unsigned _event )               { return evq_pushISR  (this, _event);         }
 };
@@ -51,6 +51,9 @@ struct __flg
 	tsk_t  * queue; // next process in the DELAYED queue
 	void   * res;   // allocated flag object's resource
 	unsigned flags; // flag's current value
+#if OS_FLAG_INDEX
+	tsk_t  * index[32]; // queues of the processes waiting for a single flag, indexed by the number of the flag
+#endif
 };
 
 /* -------------------------------------------------------------------------- */
@@ -80,7 +83,11 @@ struct __flg
  *
  ******************************************************************************/
 
+#if OS_FLAG_INDEX
+#define               _FLG_INIT() { 0, 0, 0, { 0 } }
+#else
 #define               _FLG_INIT() { 0, 0, 0 }
+#endif
 
 /******************************************************************************
  *
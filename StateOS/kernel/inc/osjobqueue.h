@@ -56,7 +56,7 @@ struct __job
 
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
-	fun_t ** data;  // data buffer
+	jbd_t  * data;  // data buffer
 };
 
 /******************************************************************************
@@ -93,7 +93,7 @@ struct __job
  ******************************************************************************/
 
 #ifndef __cplusplus
-#define               _JOB_DATA( _limit ) (fun_t *[_limit]){ 0 }
+#define               _JOB_DATA( _limit ) (jbd_t[_limit]){ { 0 } }
 #endif
 
 /******************************************************************************
@@ -109,7 +109,7 @@ struct __job
  ******************************************************************************/
 
 #define             OS_JOB( job, limit )                                 \
-                       fun_t *job##__buf[limit];                          \
+                       jbd_t  job##__buf[limit];                          \
                        job_t  job##__job = _JOB_INIT( limit, job##__buf ); \
                        job_id job = & job##__job
 
@@ -126,7 +126,7 @@ struct __job
  ******************************************************************************/
 
 #define         static_JOB( job, limit )                                 \
-                static fun_t *job##__buf[limit];                          \
+                static jbd_t  job##__buf[limit];                          \
                 static job_t  job##__job = _JOB_INIT( limit, job##__buf ); \
                 static job_id job = & job##__job
 
@@ -190,7 +190,7 @@ struct __job
  *
  ******************************************************************************/
 
-void job_init( job_t *job, unsigned limit, fun_t **data );
+void job_init( job_t *job, unsigned limit, jbd_t *data );
 
 /******************************************************************************
  *
@@ -265,6 +265,7 @@ void job_delete( job_t *job );
  *   E_TIMEOUT       : job queue object is empty and was not received data before the specified timeout expired
  *
  * Note              : use only in thread mode
+ *                     job procedure is executed outside of the critical section
  *
  ******************************************************************************/
 
@@ -289,6 +290,7 @@ unsigned job_waitUntil( job_t *job, cnt_t time );
  *   E_TIMEOUT       : job queue object is empty and was not received data before the specified timeout expired
  *
  * Note              : use only in thread mode
+ *                     job procedure is executed outside of the critical section
  *
  ******************************************************************************/
 
@@ -309,6 +311,7 @@ unsigned job_waitFor( job_t *job, cnt_t delay );
  *   E_STOPPED       : job queue object was killed
  *
  * Note              : use only in thread mode
+ *                     job procedure is executed outside of the critical section
  *
  ******************************************************************************/
 
@@ -331,6 +334,7 @@ unsigned job_wait( job_t *job ) { return job_waitFor(job, INFINITE); }
  *   E_TIMEOUT       : job queue object is empty
  *
  * Note              : may be used both in thread and handler mode
+ *                     job procedure is executed outside of the critical section
  *
  ******************************************************************************/
 
@@ -409,6 +413,79 @@ unsigned job_sendFor( job_t *job, fun_t *fun, cnt_t delay );
 __STATIC_INLINE
 unsigned job_send( job_t *job, fun_t *fun ) { return job_sendFor(job, fun, INFINITE); }
 
+/******************************************************************************
+ *
+ * Name              : job_sendArgUntil
+ *
+ * Description       : try to transfer job data to the job queue object,
+ *                     wait until given timepoint while the job queue object is full
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   act             : pointer to job procedure with an argument
+ *   arg             : argument passed to the job procedure
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : job data was successfully transfered to the job queue object
+ *   E_STOPPED       : job queue object was killed before the specified timeout expired
+ *   E_TIMEOUT       : job queue object is full and was not issued data before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned job_sendArgUntil( job_t *job, act_t *act, void *arg, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : job_sendArgFor
+ *
+ * Description       : try to transfer job data to the job queue object,
+ *                     wait for given duration of time while the job queue object is full
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   act             : pointer to job procedure with an argument
+ *   arg             : argument passed to the job procedure
+ *   delay           : duration of time (maximum number of ticks to wait while the job queue object is full)
+ *                     IMMEDIATE: don't wait if the job queue object is full
+ *                     INFINITE:  wait indefinitely while the job queue object is full
+ *
+ * Return
+ *   E_SUCCESS       : job data was successfully transfered to the job queue object
+ *   E_STOPPED       : job queue object was killed before the specified timeout expired
+ *   E_TIMEOUT       : job queue object is full and was not issued data before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned job_sendArgFor( job_t *job, act_t *act, void *arg, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : job_sendArg
+ *
+ * Description       : try to transfer job data to the job queue object,
+ *                     wait indefinitely while the job queue object is full
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   act             : pointer to job procedure with an argument
+ *   arg             : argument passed to the job procedure
+ *
+ * Return
+ *   E_SUCCESS       : job data was successfully transfered to the job queue object
+ *   E_STOPPED       : job queue object was killed
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned job_sendArg( job_t *job, act_t *act, void *arg ) { return job_sendArgFor(job, act, arg, INFINITE); }
+
 /******************************************************************************
  *
  * Name              : job_give
@@ -434,6 +511,32 @@ unsigned job_give( job_t *job, fun_t *fun );
 __STATIC_INLINE
 unsigned job_giveISR( job_t *job, fun_t *fun ) { return job_give(job, fun); }
 
+/******************************************************************************
+ *
+ * Name              : job_giveArg
+ * ISR alias         : job_giveArgISR
+ *
+ * Description       : try to transfer job data to the job queue object,
+ *                     don't wait if the job queue object is full
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   act             : pointer to job procedure with an argument
+ *   arg             : argument passed to the job procedure
+ *
+ * Return
+ *   E_SUCCESS       : job data was successfully transfered to the job queue object
+ *   E_TIMEOUT       : job queue object is full
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned job_giveArg( job_t *job, act_t *act, void *arg );
+
+__STATIC_INLINE
+unsigned job_giveArgISR( job_t *job, act_t *act, void *arg ) { return job_giveArg(job, act, arg); }
+
 /******************************************************************************
  *
  * Name              : job_push
@@ -459,6 +562,32 @@ unsigned job_push( job_t *job, fun_t *fun );
 __STATIC_INLINE
 unsigned job_pushISR( job_t *job, fun_t *fun ) { return job_push(job, fun); }
 
+/******************************************************************************
+ *
+ * Name              : job_pushArg
+ * ISR alias         : job_pushArgISR
+ *
+ * Description       : try to transfer job data to the job queue object,
+ *                     remove the oldest job data if the job queue object is full
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   act             : pointer to job procedure with an argument
+ *   arg             : argument passed to the job procedure
+ *
+ * Return
+ *   E_SUCCESS       : job data was successfully transfered to the job queue object
+ *   E_TIMEOUT       : there are tasks waiting for writing to the job queue object
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned job_pushArg( job_t *job, act_t *act, void *arg );
+
+__STATIC_INLINE
+unsigned job_pushArgISR( job_t *job, act_t *act, void *arg ) { return job_pushArg(job, act, arg); }
+
 #ifdef __cplusplus
 }
 #endif
@@ -508,7 +637,7 @@ struct baseJobQueue : public __box
 struct baseJobQueue : public __job
 {
 	 explicit
-	 baseJobQueue( const unsigned _limit, FUN_t * const _data ): __job _JOB_INIT( _limit, _data ) {}
+	 baseJobQueue( const unsigned _limit, jbd_t * const _data ): __job _JOB_INIT( _limit, _data ) {}
 	~baseJobQueue( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )                     {        job_kill     (this);               }
@@ -523,6 +652,14 @@ struct baseJobQueue : public __job
 	unsigned giveISR  ( FUN_t _fun )               { return job_giveISR  (this, _fun);         }
 	unsigned push     ( FUN_t _fun )               { return job_push     (this, _fun);         }
 	unsigned pushISR  ( FUN_t _fun )               { return job_pushISR  (this, _fun);         }
+
+	unsigned sendUntil( act_t *_act, void *_arg, cnt_t _time )  { return job_sendArgUntil(this, _act, _arg, _time);  }
+	unsigned sendFor  ( act_t *_act, void *_arg, cnt_t _delay ) { return job_sendArgFor  (this, _act, _arg, _delay); }
+	unsigned send     ( act_t *_act, void *_arg )               { return job_sendArg     (this, _act, _arg);         }
+	unsigned give     ( act_t *_act, void *_arg )               { return job_giveArg     (this, _act, _arg);         }
+	unsigned giveISR  ( act_t *_act, void *_arg )               { return job_giveArgISR  (this, _act, _arg);         }
+	unsigned push     ( act_t *_act, void *_arg )               { return job_pushArg     (this, _act, _arg);         }
+	unsigned pushISR  ( act_t *_act, void *_arg )               { return job_pushArgISR  (this, _act, _arg);         }
 };
 
 #endif
@@ -545,7 +682,11 @@ struct JobQueueT : public baseJobQueue
 	JobQueueT( void ): baseJobQueue(_limit, data_) {}
 
 	private:
+#if OS_FUNCTIONAL
 	FUN_t data_[_limit];
+#else
+	jbd_t data_[_limit];
+#endif
 };
 
 #endif
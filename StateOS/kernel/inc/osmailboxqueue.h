@@ -352,6 +352,31 @@ unsigned box_take( box_t *box, void *data );
 __STATIC_INLINE
 unsigned box_takeISR( box_t *box, void *data ) { return box_take(box, data); }
 
+/******************************************************************************
+ *
+ * Name              : box_takeMany
+ * ISR alias         : box_takeManyISR
+ *
+ * Description       : try to transfer up to 'count' mails from the mailbox queue object in one critical section,
+ *                     wake up the tasks waiting to send for the released space,
+ *                     don't wait if the mailbox queue object is empty
+ *
+ * Parameters
+ *   box             : pointer to mailbox queue object
+ *   data            : pointer to store mailbox data (array of 'count' mails)
+ *   count           : max number of mails to transfer
+ *
+ * Return            : number of mails transfered from the mailbox queue object (0 if the mailbox queue object is empty)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned box_takeMany( box_t *box, void *data, unsigned count );
+
+__STATIC_INLINE
+unsigned box_takeManyISR( box_t *box, void *data, unsigned count ) { return box_takeMany(box, data, count); }
+
 /******************************************************************************
  *
  * Name              : box_sendUntil
@@ -447,6 +472,31 @@ unsigned box_give( box_t *box, const void *data );
 __STATIC_INLINE
 unsigned box_giveISR( box_t *box, const void *data ) { return box_give(box, data); }
 
+/******************************************************************************
+ *
+ * Name              : box_giveMany
+ * ISR alias         : box_giveManyISR
+ *
+ * Description       : try to transfer up to 'count' mails to the mailbox queue object in one critical section,
+ *                     release the tasks waiting to receive first,
+ *                     don't wait if the mailbox queue object is full
+ *
+ * Parameters
+ *   box             : pointer to mailbox queue object
+ *   data            : pointer to mailbox data (array of 'count' mails)
+ *   count           : number of mails to transfer
+ *
+ * Return            : number of mails transfered to the mailbox queue object (less than 'count' if the mailbox queue object is full)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned box_giveMany( box_t *box, const void *data, unsigned count );
+
+__STATIC_INLINE
+unsigned box_giveManyISR( box_t *box, const void *data, unsigned count ) { return box_giveMany(box, data, count); }
+
 /******************************************************************************
  *
  * Name              : box_push
@@ -545,11 +595,13 @@ struct baseMailBoxQueue : public __box
 	unsigned wait     (       void *_data )               { return box_wait     (this, _data);         }
 	unsigned take     (       void *_data )               { return box_take     (this, _data);         }
 	unsigned takeISR  (       void *_data )               { return box_takeISR  (this, _data);         }
+	unsigned takeMany (       void *_data, unsigned _count ) { return box_takeMany (this, _data, _count); }
 	unsigned sendUntil( const void *_data, cnt_t _time  ) { return box_sendUntil(this, _data, _time);  }
 	unsigned sendFor  ( const void *_data, cnt_t _delay ) { return box_sendFor  (this, _data, _delay); }
 	unsigned send     ( const void *_data )               { return box_send     (this, _data);         }
 	unsigned give     ( const void *_data )               { return box_give     (this, _data);         }
 	unsigned giveISR  ( const void *_data )               { return box_giveISR  (this, _data);         }
+	unsigned giveMany ( const void *_data, unsigned _count ) { return box_giveMany (this, _data, _count); }
 	unsigned push     ( const void *_data )               { return box_push     (this, _data);         }
 	unsigned pushISR  ( const void *_data )               { return box_pushISR  (this, _data);         }
 	unsigned count    ( void )                            { return box_count    (this);                }
@@ -49,9 +49,10 @@ typedef struct __mem mem_t, * const mem_id;
 
 struct __mem
 {
-	tsk_t  * queue; // inherited from list
+	tsk_t  * queue; // next process in the DELAYED queue
 	void   * res;   // allocated memory pool object's resource
-	que_t    head;  // inherited from list
+	volatile
+	uint32_t head;  // tagged index of the first free memory object (the link is stored in the data of the object)
 
 	unsigned limit; // size of a memory pool (max number of objects)
 	unsigned size;  // size of memory object (in words)
@@ -63,6 +64,15 @@ struct __mem
 #define MSIZE( size ) \
  ALIGNED_SIZE( size, que_t )
 
+/* -------------------------------------------------------------------------- */
+// size of the header of memory object (in words)
+
+#if     OS_MEM_COMPACT
+#define MHEAD         0 // memory object has no header
+#else
+#define MHEAD         1 // header allows to transfer the memory object through the list object
+#endif
+
 /******************************************************************************
  *
  * Name              : _MEM_INIT
@@ -79,7 +89,7 @@ struct __mem
  *
  ******************************************************************************/
 
-#define               _MEM_INIT( _limit, _size, _data ) { 0, 0, _QUE_INIT(), _limit, MSIZE(_size), _data }
+#define               _MEM_INIT( _limit, _size, _data ) { 0, 0, 0, _limit, MSIZE(_size), _data }
 
 /******************************************************************************
  *
@@ -98,7 +108,7 @@ struct __mem
  ******************************************************************************/
 
 #ifndef __cplusplus
-#define               _MEM_DATA( _limit, _size ) (void *[_limit * (1 + MSIZE(_size))]){ 0 }
+#define               _MEM_DATA( _limit, _size ) (void *[_limit * (MHEAD + MSIZE(_size))]){ 0 }
 #endif
 
 /******************************************************************************
@@ -115,7 +125,7 @@ struct __mem
  ******************************************************************************/
 
 #define             OS_MEM( mem, limit, size )                                \
-                       void*mem##__buf[limit*(1+MSIZE(size))];                 \
+                       void*mem##__buf[limit*(MHEAD+MSIZE(size))];              \
                        mem_t mem##__mem = _MEM_INIT( limit, size, mem##__buf ); \
                        mem_id mem = & mem##__mem
 
@@ -133,7 +143,7 @@ struct __mem
  ******************************************************************************/
 
 #define         static_MEM( mem, limit, size )                                \
-                static void*mem##__buf[limit*(1+MSIZE(size))];                 \
+                static void*mem##__buf[limit*(MHEAD+MSIZE(size))];              \
                 static mem_t mem##__mem = _MEM_INIT( limit, size, mem##__buf ); \
                 static mem_id mem = & mem##__mem
 
@@ -297,8 +307,7 @@ void mem_delete( mem_t *mem );
  *
  ******************************************************************************/
 
-__STATIC_INLINE
-unsigned mem_waitUntil( mem_t *mem, void **data, cnt_t time ) { return lst_waitUntil((lst_t *)mem, data, time); }
+unsigned mem_waitUntil( mem_t *mem, void **data, cnt_t time );
 
 /******************************************************************************
  *
@@ -323,8 +332,7 @@ unsigned mem_waitUntil( mem_t *mem, void **data, cnt_t time ) { return lst_waitU
  *
  ******************************************************************************/
 
-__STATIC_INLINE
-unsigned mem_waitFor( mem_t *mem, void **data, cnt_t delay ) { return lst_waitFor((lst_t *)mem, data, delay); }
+unsigned mem_waitFor( mem_t *mem, void **data, cnt_t delay );
 
 /******************************************************************************
  *
@@ -346,7 +354,7 @@ unsigned mem_waitFor( mem_t *mem, void **data, cnt_t delay ) { return lst_waitFo
  ******************************************************************************/
 
 __STATIC_INLINE
-unsigned mem_wait( mem_t *mem, void **data ) { return lst_wait((lst_t *)mem, data); }
+unsigned mem_wait( mem_t *mem, void **data ) { return mem_waitFor(mem, data, INFINITE); }
 
 /******************************************************************************
  *
@@ -368,11 +376,10 @@ unsigned mem_wait( mem_t *mem, void **data ) { return lst_wait((lst_t *)mem, dat
  *
  ******************************************************************************/
 
-__STATIC_INLINE
-unsigned mem_take( mem_t *mem, void **data ) { return lst_take((lst_t*)mem, data); }
+unsigned mem_take( mem_t *mem, void **data );
 
 __STATIC_INLINE
-unsigned mem_takeISR( mem_t *mem, void **data ) { return lst_takeISR((lst_t *)mem, data); }
+unsigned mem_takeISR( mem_t *mem, void **data ) { return mem_take(mem, data); }
 
 /******************************************************************************
  *
@@ -380,6 +387,7 @@ unsigned mem_takeISR( mem_t *mem, void **data ) { return lst_takeISR((lst_t *)me
  * ISR alias         : mem_giveISR
  *
  * Description       : transfer memory object to the memory pool object,
+ *                     memory object that does not belong to the memory pool object is rejected
  *
  * Parameters
  *   mem             : pointer to memory pool object
@@ -391,11 +399,51 @@ unsigned mem_takeISR( mem_t *mem, void **data ) { return lst_takeISR((lst_t *)me
  *
  ******************************************************************************/
 
+void mem_give( mem_t *mem, const void *data );
+
 __STATIC_INLINE
-void mem_give( mem_t *mem, const void *data ) { lst_give((lst_t *)mem, data); }
+void mem_giveISR( mem_t *mem, const void *data ) { mem_give(mem, data); }
+
+/******************************************************************************
+ *
+ * Name              : mem_owns
+ *
+ * Description       : check if the memory object belongs to the memory pool object
+ *
+ * Parameters
+ *   mem             : pointer to memory pool object
+ *   data            : pointer to memory object
+ *
+ * Return
+ *   true            : memory object is one of the objects of the memory pool buffer
+ *   false           : memory object is out of the memory pool buffer or is not aligned to the object boundary
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+bool mem_owns( mem_t *mem, const void *data );
+
+/******************************************************************************
+ *
+ * Name              : mem_space
+ * ISR alias         : mem_spaceISR
+ *
+ * Description       : return the number of free memory objects in the memory pool object
+ *
+ * Parameters
+ *   mem             : pointer to memory pool object
+ *
+ * Return            : number of free memory objects
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned mem_space( mem_t *mem );
 
 __STATIC_INLINE
-void mem_giveISR( mem_t *mem, const void *data ) { lst_giveISR((lst_t *)mem, data); }
+unsigned mem_spaceISR( mem_t *mem ) { return mem_space(mem); }
 
 #ifdef __cplusplus
 }
@@ -434,6 +482,9 @@ struct baseMemoryPool : public __mem
 	unsigned takeISR  (       void **_data )               { return mem_takeISR  (this, _data);         }
 	void     give     ( const void  *_data )               {        mem_give     (this, _data);         }
 	void     giveISR  ( const void  *_data )               {        mem_giveISR  (this, _data);         }
+	bool     owns     ( const void  *_data )               { return mem_owns     (this, _data);         }
+	unsigned space    ( void )                             { return mem_space    (this);                }
+	unsigned spaceISR ( void )                             { return mem_spaceISR (this);                }
 };
 
 /******************************************************************************
@@ -455,7 +506,7 @@ struct MemoryPoolT : public baseMemoryPool
 	MemoryPoolT( void ): baseMemoryPool(_limit, _size, reinterpret_cast<void *>(data_)) {}
 
 	private:
-	void *data_[_limit * (1 + MSIZE(_size))];
+	void *data_[_limit * (MHEAD + MSIZE(_size))];
 };
 
 /******************************************************************************
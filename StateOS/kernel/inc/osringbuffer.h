@@ -0,0 +1,510 @@
+/******************************************************************************
+
+    @file    StateOS: osringbuffer.h
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_RNG_H
+#define __STATEOS_RNG_H
+
+#include "oskernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : ring buffer
+ *
+ * Note              : lock-free queue for a single producer and a single consumer,
+ *                     the producer never enters a critical section unless the consumer is waiting,
+ *                     so the producer handler must be masked by the critical section (OS_LOCK_LEVEL)
+ *
+ ******************************************************************************/
+
+typedef struct __rng rng_t, * const rng_id;
+
+struct __rng
+{
+	tsk_t  * queue; // next process in the DELAYED queue
+	void   * res;   // allocated ring buffer object's resource
+	unsigned limit; // size of a ring buffer (max number of stored elements)
+	unsigned size;  // size of a single element (in bytes)
+
+	volatile
+	unsigned head;  // first element to read from data buffer (modulo 2*limit)
+	volatile
+	unsigned tail;  // first element to write into data buffer (modulo 2*limit)
+	char   * data;  // data buffer
+};
+
+/******************************************************************************
+ *
+ * Name              : _RNG_INIT
+ *
+ * Description       : create and initialize a ring buffer object
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored elements)
+ *   data            : ring buffer data buffer
+ *   size            : size of a single element (in bytes)
+ *
+ * Return            : ring buffer object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _RNG_INIT( _limit, _data, _size ) { 0, 0, _limit, _size, 0, 0, _data }
+
+/******************************************************************************
+ *
+ * Name              : _RNG_DATA
+ *
+ * Description       : create a ring buffer data buffer
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored elements)
+ *   size            : size of a single element (in bytes)
+ *
+ * Return            : ring buffer data buffer
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define               _RNG_DATA( _limit, _size ) (char[(_limit) * (_size)]){ 0 }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : OS_RNG
+ *
+ * Description       : define and initialize a ring buffer object
+ *
+ * Parameters
+ *   rng             : name of a pointer to ring buffer object
+ *   limit           : size of a buffer (max number of stored elements)
+ *   size            : size of a single element (in bytes)
+ *
+ ******************************************************************************/
+
+#define             OS_RNG( rng, limit, size )                                \
+                       char rng##__buf[(limit)*(size)];                       \
+                       rng_t rng##__rng = _RNG_INIT( limit, rng##__buf, size ); \
+                       rng_id rng = & rng##__rng
+
+/******************************************************************************
+ *
+ * Name              : static_RNG
+ *
+ * Description       : define and initialize a static ring buffer object
+ *
+ * Parameters
+ *   rng             : name of a pointer to ring buffer object
+ *   limit           : size of a buffer (max number of stored elements)
+ *   size            : size of a single element (in bytes)
+ *
+ ******************************************************************************/
+
+#define         static_RNG( rng, limit, size )                                \
+                static char rng##__buf[(limit)*(size)];                       \
+                static rng_t rng##__rng = _RNG_INIT( limit, rng##__buf, size ); \
+                static rng_id rng = & rng##__rng
+
+/******************************************************************************
+ *
+ * Name              : RNG_INIT
+ *
+ * Description       : create and initialize a ring buffer object
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored elements)
+ *   size            : size of a single element (in bytes)
+ *
+ * Return            : ring buffer object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                RNG_INIT( limit, size ) \
+                      _RNG_INIT( limit, _RNG_DATA( limit, size ), size )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : RNG_CREATE
+ * Alias             : RNG_NEW
+ *
+ * Description       : create and initialize a ring buffer object
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored elements)
+ *   size            : size of a single element (in bytes)
+ *
+ * Return            : pointer to ring buffer object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                RNG_CREATE( limit, size ) \
+             & (rng_t) RNG_INIT  ( limit, size )
+#define                RNG_NEW \
+                       RNG_CREATE
+#endif
+
+/******************************************************************************
+ *
+ * Name              : rng_init
+ *
+ * Description       : initialize a ring buffer object
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *   limit           : size of a buffer (max number of stored elements)
+ *   data            : ring buffer data buffer
+ *   size            : size of a single element (in bytes)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void rng_init( rng_t *rng, unsigned limit, void *data, unsigned size );
+
+/******************************************************************************
+ *
+ * Name              : rng_create
+ * Alias             : rng_new
+ *
+ * Description       : create and initialize a new ring buffer object
+ *
+ * Parameters
+ *   limit           : size of a buffer (max number of stored elements)
+ *   size            : size of a single element (in bytes)
+ *
+ * Return            : pointer to ring buffer object (ring buffer successfully created)
+ *   0               : ring buffer not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+rng_t *rng_create( unsigned limit, unsigned size );
+
+__STATIC_INLINE
+rng_t *rng_new( unsigned limit, unsigned size ) { return rng_create(limit, size); }
+
+/******************************************************************************
+ *
+ * Name              : rng_kill
+ *
+ * Description       : reset the ring buffer object and wake up the waiting task with 'E_STOPPED' event value
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     the producer must not use the ring buffer object at that time
+ *
+ ******************************************************************************/
+
+void rng_kill( rng_t *rng );
+
+/******************************************************************************
+ *
+ * Name              : rng_delete
+ *
+ * Description       : reset the ring buffer object and free allocated resource
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     the producer must not use the ring buffer object at that time
+ *
+ ******************************************************************************/
+
+void rng_delete( rng_t *rng );
+
+/******************************************************************************
+ *
+ * Name              : rng_waitUntil
+ *
+ * Description       : try to transfer data from the ring buffer object,
+ *                     wait until given timepoint while the ring buffer object is empty
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *   data            : pointer to store data
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the ring buffer object
+ *   E_STOPPED       : ring buffer object was killed before the specified timeout expired
+ *   E_TIMEOUT       : ring buffer object is empty and was not received data before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     only one task can read from the ring buffer object
+ *
+ ******************************************************************************/
+
+unsigned rng_waitUntil( rng_t *rng, void *data, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : rng_waitFor
+ *
+ * Description       : try to transfer data from the ring buffer object,
+ *                     wait for given duration of time while the ring buffer object is empty
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *   data            : pointer to store data
+ *   delay           : duration of time (maximum number of ticks to wait while the ring buffer object is empty)
+ *                     IMMEDIATE: don't wait if the ring buffer object is empty
+ *                     INFINITE:  wait indefinitely while the ring buffer object is empty
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the ring buffer object
+ *   E_STOPPED       : ring buffer object was killed before the specified timeout expired
+ *   E_TIMEOUT       : ring buffer object is empty and was not received data before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     only one task can read from the ring buffer object
+ *
+ ******************************************************************************/
+
+unsigned rng_waitFor( rng_t *rng, void *data, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : rng_wait
+ *
+ * Description       : try to transfer data from the ring buffer object,
+ *                     wait indefinitely while the ring buffer object is empty
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *   data            : pointer to store data
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the ring buffer object
+ *   E_STOPPED       : ring buffer object was killed
+ *
+ * Note              : use only in thread mode
+ *                     only one task can read from the ring buffer object
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned rng_wait( rng_t *rng, void *data ) { return rng_waitFor(rng, data, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : rng_take
+ * ISR alias         : rng_takeISR
+ *
+ * Description       : try to transfer data from the ring buffer object,
+ *                     don't wait if the ring buffer object is empty
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *   data            : pointer to store data
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the ring buffer object
+ *   E_TIMEOUT       : ring buffer object is empty
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only one consumer can read from the ring buffer object
+ *                     does not enter a critical section
+ *
+ ******************************************************************************/
+
+unsigned rng_take( rng_t *rng, void *data );
+
+__STATIC_INLINE
+unsigned rng_takeISR( rng_t *rng, void *data ) { return rng_take(rng, data); }
+
+/******************************************************************************
+ *
+ * Name              : rng_give
+ * ISR alias         : rng_giveISR
+ *
+ * Description       : try to transfer data to the ring buffer object,
+ *                     don't wait if the ring buffer object is full
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *   data            : pointer to data
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered to the ring buffer object
+ *   E_TIMEOUT       : ring buffer object is full
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only one producer can write to the ring buffer object
+ *                     enters a critical section only to resume the waiting consumer,
+ *                     so the handler must have the urgency not higher than OS_LOCK_LEVEL (it is masked by the critical section);
+ *                     a handler above OS_LOCK_LEVEL could corrupt the DELAYED queue or miss the consumer that is just going to wait
+ *
+ ******************************************************************************/
+
+unsigned rng_give( rng_t *rng, const void *data );
+
+__STATIC_INLINE
+unsigned rng_giveISR( rng_t *rng, const void *data ) { return rng_give(rng, data); }
+
+/******************************************************************************
+ *
+ * Name              : rng_count
+ * ISR alias         : rng_countISR
+ *
+ * Description       : return the amount of data contained in the ring buffer
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *
+ * Return            : amount of data contained in the ring buffer
+ *
+ ******************************************************************************/
+
+unsigned rng_count( rng_t *rng );
+
+__STATIC_INLINE
+unsigned rng_countISR( rng_t *rng ) { return rng_count(rng); }
+
+/******************************************************************************
+ *
+ * Name              : rng_space
+ * ISR alias         : rng_spaceISR
+ *
+ * Description       : return the amount of free space in the ring buffer
+ *
+ * Parameters
+ *   rng             : pointer to ring buffer object
+ *
+ * Return            : amount of free space in the ring buffer
+ *
+ ******************************************************************************/
+
+unsigned rng_space( rng_t *rng );
+
+__STATIC_INLINE
+unsigned rng_spaceISR( rng_t *rng ) { return rng_space(rng); }
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : baseRing
+ *
+ * Description       : create and initialize a ring buffer object
+ *
+ * Constructor parameters
+ *   limit           : size of a buffer (max number of stored elements)
+ *   data            : ring buffer data buffer
+ *   size            : size of a single element (in bytes)
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+struct baseRing : public __rng
+{
+	 explicit
+	 baseRing( const unsigned _limit, char * const _data, const unsigned _size ): __rng _RNG_INIT(_limit, _data, _size) {}
+	~baseRing( void ) { assert(queue == nullptr); }
+
+	void     kill     ( void )                            {        rng_kill     (this);                }
+	unsigned waitUntil(       void *_data, cnt_t _time  ) { return rng_waitUntil(this, _data, _time);  }
+	unsigned waitFor  (       void *_data, cnt_t _delay ) { return rng_waitFor  (this, _data, _delay); }
+	unsigned wait     (       void *_data )               { return rng_wait     (this, _data);         }
+	unsigned take     (       void *_data )               { return rng_take     (this, _data);         }
+	unsigned takeISR  (       void *_data )               { return rng_takeISR  (this, _data);         }
+	unsigned give     ( const void *_data )               { return rng_give     (this, _data);         }
+	unsigned giveISR  ( const void *_data )               { return rng_giveISR  (this, _data);         }
+	unsigned count    ( void )                            { return rng_count    (this);                }
+	unsigned countISR ( void )                            { return rng_countISR (this);                }
+	unsigned space    ( void )                            { return rng_space    (this);                }
+	unsigned spaceISR ( void )                            { return rng_spaceISR (this);                }
+};
+
+/******************************************************************************
+ *
+ * Class             : Ring
+ *
+ * Description       : create and initialize a ring buffer object
+ *
+ * Constructor parameters
+ *   limit           : size of a buffer (max number of stored objects)
+ *   T               : class of an object
+ *
+ ******************************************************************************/
+
+template<unsigned _limit, class T>
+struct RingT : public baseRing
+{
+	explicit
+	RingT( void ): baseRing(_limit, reinterpret_cast<char *>(data_), sizeof(T)) {}
+
+	unsigned waitUntil(       T *_data, cnt_t _time  ) { return rng_waitUntil(this, _data, _time);  }
+	unsigned waitFor  (       T *_data, cnt_t _delay ) { return rng_waitFor  (this, _data, _delay); }
+	unsigned wait     (       T *_data )               { return rng_wait     (this, _data);         }
+	unsigned take     (       T *_data )               { return rng_take     (this, _data);         }
+	unsigned takeISR  (       T *_data )               { return rng_takeISR  (this, _data);         }
+	unsigned give     ( const T *_data )               { return rng_give     (this, _data);         }
+	unsigned giveISR  ( const T *_data )               { return rng_giveISR  (this, _data);         }
+
+	private:
+	T data_[_limit];
+};
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_RNG_H
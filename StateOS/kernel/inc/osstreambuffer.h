@@ -478,6 +478,100 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size );
 __STATIC_INLINE
 unsigned stm_pushISR( stm_t *stm, const void *data, unsigned size ) { return stm_push(stm, data, size); }
 
+/******************************************************************************
+ *
+ * Name              : stm_reserve
+ * ISR alias         : stm_reserveISR
+ *
+ * Description       : get direct access to the contiguous free space of the stream buffer object,
+ *                     the space has to be filled with data and then passed to the stream buffer with stm_commit
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to the variable receiving the address of the free space
+ *
+ * Return            : size of the contiguous free space (0 if there is no free space)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     no data can be written into the stream buffer object by other means until stm_commit
+ *
+ ******************************************************************************/
+
+unsigned stm_reserve( stm_t *stm, void **data );
+
+__STATIC_INLINE
+unsigned stm_reserveISR( stm_t *stm, void **data ) { return stm_reserve(stm, data); }
+
+/******************************************************************************
+ *
+ * Name              : stm_commit
+ * ISR alias         : stm_commitISR
+ *
+ * Description       : pass data written into the space obtained with stm_reserve to the stream buffer object,
+ *                     resume tasks waiting for reading from the stream buffer object
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   size            : size of written data (must not be greater than the size returned by stm_reserve)
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+void stm_commit( stm_t *stm, unsigned size );
+
+__STATIC_INLINE
+void stm_commitISR( stm_t *stm, unsigned size ) { stm_commit(stm, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_peek
+ * ISR alias         : stm_peekISR
+ *
+ * Description       : get direct access to the contiguous data of the stream buffer object,
+ *                     data has to be released with stm_consume
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to the variable receiving the address of the data
+ *
+ * Return            : size of the contiguous data (0 if the stream buffer object is empty)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     no data can be read from the stream buffer object by other means until stm_consume
+ *
+ ******************************************************************************/
+
+unsigned stm_peek( stm_t *stm, void **data );
+
+__STATIC_INLINE
+unsigned stm_peekISR( stm_t *stm, void **data ) { return stm_peek(stm, data); }
+
+/******************************************************************************
+ *
+ * Name              : stm_consume
+ * ISR alias         : stm_consumeISR
+ *
+ * Description       : release data obtained with stm_peek from the stream buffer object,
+ *                     resume tasks waiting for writing to the stream buffer object
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   size            : size of released data (must not be greater than the size returned by stm_peek)
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+void stm_consume( stm_t *stm, unsigned size );
+
+__STATIC_INLINE
+void stm_consumeISR( stm_t *stm, unsigned size ) { stm_consume(stm, size); }
+
 /******************************************************************************
  *
  * Name              : stm_count
@@ -557,6 +651,14 @@ struct baseStreamBuffer : public __stm
 	unsigned giveISR  ( const void *_data, unsigned _size )               { return stm_giveISR  (this, _data, _size);         }
 	unsigned push     ( const void *_data, unsigned _size )               { return stm_push     (this, _data, _size);         }
 	unsigned pushISR  ( const void *_data, unsigned _size )               { return stm_pushISR  (this, _data, _size);         }
+	unsigned reserve  ( void **_data )                                    { return stm_reserve  (this, _data);                }
+	unsigned reserveISR( void **_data )                                   { return stm_reserveISR(this, _data);               }
+	void     commit   ( unsigned _size )                                  {        stm_commit   (this, _size);                }
+	void     commitISR( unsigned _size )                                  {        stm_commitISR(this, _size);                }
+	unsigned peek     ( void **_data )                                    { return stm_peek     (this, _data);                }
+	unsigned peekISR  ( void **_data )                                    { return stm_peekISR  (this, _data);                }
+	void     consume  ( unsigned _size )                                  {        stm_consume  (this, _size);                }
+	void     consumeISR( unsigned _size )                                 {        stm_consumeISR(this, _size);               }
 	unsigned count    ( void )                                            { return stm_count    (this);                       }
 	unsigned countISR ( void )                                            { return stm_countISR (this);                       }
 	unsigned space    ( void )                                            { return stm_space    (this);                       }
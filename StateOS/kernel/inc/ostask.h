@@ -34,6 +34,7 @@
 
 #include "oskernel.h"
 #include "osmutex.h"
+#include "osceilingmutex.h"
 #include "ostimer.h"
 
 #ifdef __cplusplus
@@ -46,6 +47,24 @@ extern "C" {
  *
  ******************************************************************************/
 
+/******************************************************************************
+ *
+ * Name              : task statistics
+ *
+ ******************************************************************************/
+
+typedef struct __tst tst_t;
+
+struct __tst
+{
+	uint64_t time;    // run time of the task (in cycles of the cycle counter)
+	unsigned count;   // number of context switches to the task
+	unsigned preempt; // number of times the task was preempted
+	unsigned yield;   // number of times the task gave up the processor voluntarily (yielded, waited or stopped)
+};
+
+/* -------------------------------------------------------------------------- */
+
 struct __tsk
 {
 	obj_t    obj;   // inherited from timer
@@ -54,6 +73,9 @@ struct __tsk
 	fun_t  * state; // task state (initial task function, doesn't have to be noreturn-type)
 	cnt_t    start; // inherited from timer
 	cnt_t    delay; // inherited from timer
+#if OS_TIMER_WHEEL
+	tmr_t ** whl;   // inherited from timer
+#endif
 	cnt_t    slice;	// time slice
 
 	tsk_t  * back;  // previous process in the DELAYED queue
@@ -74,6 +96,8 @@ struct __tsk
 	tsk_t  * tree;  // tree of tasks waiting for mutexes
 	}        mtx;
 
+	pcm_t  * pcm;   // last locked priority ceiling mutex
+
 	union  {
 
 	struct {
@@ -116,17 +140,42 @@ struct __tsk
 	}        box;   // temporary data used by mailbox queue object
 
 	struct {
-	fun_t  * fun;
-	}        job;   // temporary data used by job queue object
+	union  {
+	const
+	void   * out;
+	void   * in;
+	}        data;
+	unsigned prio;
+	}        pbx;   // temporary data used by priority mailbox queue object
+
+	jbd_t    job;   // temporary data used by job queue object
 
 	struct {
 	unsigned event;
 	}        evq;   // temporary data used by event queue object
 
+	struct {
+	mtx_t  * mtx;
+	bool     morph; // the task was moved to the mutex queue by cnd_give
+	}        cnd;   // temporary data used by condition variable object
+
 	}        tmp;
 #if defined(__ARMCC_VERSION) && !defined(__MICROLIB)
 	char     libspace[96];
 #endif
+#if OS_TASK_STATS
+	tst_t    stat;  // run-time statistics
+	uint32_t cyc;   // cycle counter value at the last context switch to the task
+#endif
+#if OS_STACK_PAINT
+	stk_t  * mark;  // stack high-water mark, the lowest word of the painted stack that has been used
+#endif
+#if __FPU_USED
+	bool     nofpu; // the task does not use the floating-point unit
+#endif
+#if OS_SRP_STACK
+	tsk_t  * srp;   // run-to-completion task started before on the shared stack
+#endif
 };
 
 /******************************************************************************
@@ -148,12 +197,36 @@ struct __tsk
  *
  ******************************************************************************/
 
+#if OS_TASK_STATS
+#define               _TSK_STAT , { 0, 0, 0, 0 }, 0
+#else
+#define               _TSK_STAT
+#endif
+
+#if OS_STACK_PAINT
+#define               _TSK_MARK , 0
+#else
+#define               _TSK_MARK
+#endif
+
+#if __FPU_USED
+#define               _TSK_FPU  , 0
+#else
+#define               _TSK_FPU
+#endif
+
+#if OS_SRP_STACK
+#define               _TSK_SRP  , 0
+#else
+#define               _TSK_SRP
+#endif
+
 #if defined(__ARMCC_VERSION) && !defined(__MICROLIB)
 #define               _TSK_INIT( _prio, _state, _stack, _size ) \
-                       { _OBJ_INIT(), 0, _state, 0, 0, 0, 0, 0, _stack+SSIZE(_size), _stack, _prio, _prio, 0, 0, 0, { 0, 0 }, { { 0, 0 } }, { 0 } }
+                       { _OBJ_INIT(), 0, _state, 0, 0, _TMR_WHL 0, 0, 0, _stack+SSIZE(_size), _stack, _prio, _prio, 0, 0, 0, { 0, 0 }, 0, { { 0, 0 } }, { 0 } _TSK_STAT _TSK_MARK _TSK_FPU _TSK_SRP }
 #else
 #define               _TSK_INIT( _prio, _state, _stack, _size ) \
-                       { _OBJ_INIT(), 0, _state, 0, 0, 0, 0, 0, _stack+SSIZE(_size), _stack, _prio, _prio, 0, 0, 0, { 0, 0 }, { { 0, 0 } } }
+                       { _OBJ_INIT(), 0, _state, 0, 0, _TMR_WHL 0, 0, 0, _stack+SSIZE(_size), _stack, _prio, _prio, 0, 0, 0, { 0, 0 }, 0, { { 0, 0 } } _TSK_STAT _TSK_MARK _TSK_FPU _TSK_SRP }
 #endif
 
 /******************************************************************************
@@ -424,6 +497,92 @@ struct __tsk
 #define         static_TSK_START( tsk, prio ) \
                 static_WRK_START( tsk, prio, OS_STACK_SIZE )
 
+/******************************************************************************
+ *
+ * Name              : OS_SRP
+ *
+ * Description       : define and initialize run-to-completion task object, which uses the shared stack
+ *
+ * Parameters
+ *   tsk             : name of a pointer to task object
+ *   prio            : preemption level of the task (task priority)
+ *   state           : task state (task function), executed once after every start of the task
+ *
+ * Note              : available only when OS_SRP_STACK is set
+ *
+ ******************************************************************************/
+
+#if OS_SRP_STACK
+#define             OS_SRP( tsk, prio, state )                                       \
+                       tsk_t tsk##__tsk = _TSK_INIT( prio, state, SRP_STK, OS_SRP_STACK ); \
+                       tsk_id tsk = & tsk##__tsk
+#endif
+
+/******************************************************************************
+ *
+ * Name              : OS_SRP_DEF
+ *
+ * Description       : define and initialize run-to-completion task object, which uses the shared stack
+ *                     task state (function body) must be defined immediately below
+ *
+ * Parameters
+ *   tsk             : name of a pointer to task object
+ *   prio            : preemption level of the task (task priority)
+ *
+ * Note              : available only when OS_SRP_STACK is set
+ *
+ ******************************************************************************/
+
+#if OS_SRP_STACK
+#define             OS_SRP_DEF( tsk, prio )        \
+                       void tsk##__fun( void );     \
+                    OS_SRP( tsk, prio, tsk##__fun ); \
+                       void tsk##__fun( void )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : static_SRP
+ *
+ * Description       : define and initialize static run-to-completion task object, which uses the shared stack
+ *
+ * Parameters
+ *   tsk             : name of a pointer to task object
+ *   prio            : preemption level of the task (task priority)
+ *   state           : task state (task function), executed once after every start of the task
+ *
+ * Note              : available only when OS_SRP_STACK is set
+ *
+ ******************************************************************************/
+
+#if OS_SRP_STACK
+#define         static_SRP( tsk, prio, state )                                       \
+                static tsk_t tsk##__tsk = _TSK_INIT( prio, state, SRP_STK, OS_SRP_STACK ); \
+                static tsk_id tsk = & tsk##__tsk
+#endif
+
+/******************************************************************************
+ *
+ * Name              : static_SRP_DEF
+ *
+ * Description       : define and initialize static run-to-completion task object, which uses the shared stack
+ *                     task state (function body) must be defined immediately below
+ *
+ * Parameters
+ *   tsk             : name of a pointer to task object
+ *   prio            : preemption level of the task (task priority)
+ *
+ * Note              : available only when OS_SRP_STACK is set
+ *
+ ******************************************************************************/
+
+#if OS_SRP_STACK
+#define         static_SRP_DEF( tsk, prio )        \
+                static void tsk##__fun( void );     \
+                static_SRP( tsk, prio, tsk##__fun ); \
+                static void tsk##__fun( void )
+#endif
+
 /******************************************************************************
  *
  * Name              : WRK_INIT
@@ -609,6 +768,34 @@ tsk_t *tsk_create( unsigned prio, fun_t *state ) { return wrk_create(prio, state
 __STATIC_INLINE
 tsk_t *tsk_new   ( unsigned prio, fun_t *state ) { return wrk_create(prio, state, OS_STACK_SIZE); }
 
+/******************************************************************************
+ *
+ * Name              : srp_init
+ *
+ * Description       : initialize run-to-completion task object, which uses the shared stack, and start the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   prio            : preemption level of the task (task priority)
+ *   state           : task state (task function), executed once after every start of the task
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     available only when OS_SRP_STACK is set
+ *                     the task is scheduled under the Stack Resource Policy: its context is created on the shared stack
+ *                     when the task is dispatched for the first time after the start and it is released when the task
+ *                     function returns; the task can be preempted only by tasks of higher priority, so the tasks
+ *                     started on the shared stack always complete in the reverse order;
+ *                     the task must not wait (for any object, delay or suspend) and it must not lower its priority,
+ *                     it shares the data with other tasks using the resource ceilings (srp_lock / srp_unlock)
+ *
+ ******************************************************************************/
+
+#if OS_SRP_STACK
+void srp_init( tsk_t *tsk, unsigned prio, fun_t *state );
+#endif
+
 /******************************************************************************
  *
  * Name              : tsk_start
@@ -757,6 +944,41 @@ void tsk_yield( void );
 __STATIC_INLINE
 void tsk_pass ( void ) { tsk_yield(); }
 
+/******************************************************************************
+ *
+ * Name              : tsk_lock
+ *
+ * Description       : lock the scheduler, the current task is not preempted until the scheduler is unlocked
+ *                     interrupts are still serviced, context switches they request are deferred
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     calls can be nested, the current task must not wait, stop, restart or kill itself while the scheduler is locked
+ *
+ ******************************************************************************/
+
+void tsk_lock( void );
+
+/******************************************************************************
+ *
+ * Name              : tsk_unlock
+ *
+ * Description       : unlock the scheduler locked by tsk_lock
+ *                     the last unlock performs the deferred context switch
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void tsk_unlock( void );
+
 /******************************************************************************
  *
  * Name              : tsk_flip
@@ -813,6 +1035,114 @@ void tsk_setPrio( unsigned prio ) { tsk_prio(prio); }
 __STATIC_INLINE
 unsigned tsk_getPrio( void ) { return System.cur->basic; }
 
+/******************************************************************************
+ *
+ * Name              : srp_lock
+ *
+ * Description       : lock the resource: raise priority of the current task to the resource ceiling
+ *
+ * Parameters
+ *   ceiling         : resource ceiling, the highest priority of the tasks using the resource
+ *
+ * Return            : previous priority of the current task, which must be passed to srp_unlock
+ *
+ * Note              : use only in thread mode
+ *                     tasks with priority not higher than the ceiling are not started / resumed until the resource is unlocked,
+ *                     so the resource is never contended; resources must be unlocked in the reverse order of locking
+ *
+ ******************************************************************************/
+
+unsigned srp_lock( unsigned ceiling );
+
+/******************************************************************************
+ *
+ * Name              : srp_unlock
+ *
+ * Description       : unlock the resource: restore priority of the current task
+ *
+ * Parameters
+ *   prio            : priority of the current task returned by srp_lock
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void srp_unlock( unsigned prio ) { tsk_prio(prio); }
+
+/******************************************************************************
+ *
+ * Name              : tsk_getStats
+ *
+ * Description       : get run-time statistics of the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   stat            : pointer to structure to store statistics
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     available only when OS_TASK_STATS is set
+ *
+ ******************************************************************************/
+
+#if OS_TASK_STATS
+void tsk_getStats( tsk_t *tsk, tst_t *stat );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_stackUsage
+ *
+ * Description       : get peak stack usage (stack high-water mark) of the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : peak number of bytes used in the task's stack since the task was started
+ *                     for run-to-completion tasks: peak number of bytes used in the shared stack (OS_SRP_STACK) since the first of them was started
+ *                     0 if the stack of the task is not painted (main and idle tasks)
+ *
+ * Note              : use only in thread mode
+ *                     available only when OS_STACK_PAINT is set
+ *                     the stack is scanned only below the high-water mark recorded before
+ *                     (by the previous call or, when OS_STACK_CHECK is set, by the idle task)
+ *
+ ******************************************************************************/
+
+#if OS_STACK_PAINT
+unsigned tsk_stackUsage( tsk_t *tsk );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_setFPU
+ *
+ * Description       : declare whether the task uses the floating-point unit
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   use             : false: the task does not use the floating-point unit
+ *                     true:  the task can use the floating-point unit (default)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     available only on cores with the floating-point unit (__FPU_USED)
+ *                     context of the task that does not use the floating-point unit is always saved in the short frame,
+ *                     so the stack of the task can be smaller by the size of the floating-point context (136 bytes);
+ *                     it is asserted in the context switch handler
+ *
+ ******************************************************************************/
+
+#if __FPU_USED
+__STATIC_INLINE
+void tsk_setFPU( tsk_t *tsk, bool use ) { tsk->nofpu = !use; }
+#endif
+
 /******************************************************************************
  *
  * Name              : tsk_waitUntil
@@ -1060,6 +1390,15 @@ struct baseTask : public __tsk
 
 	unsigned prio     ( void )            { return __tsk::basic;                 }
 	unsigned getPrio  ( void )            { return __tsk::basic;                 }
+#if OS_TASK_STATS
+	void     getStats ( tst_t  * _stat  ) {        tsk_getStats  (this, _stat);  }
+#endif
+#if OS_STACK_PAINT
+	unsigned stackUsage( void )           { return tsk_stackUsage(this);         }
+#endif
+#if __FPU_USED
+	void     setFPU   ( bool     _use   ) {        tsk_setFPU    (this, _use);   }
+#endif
 	bool     operator!( void )            { return __tsk::id == ID_STOPPED;      }
 #if OS_FUNCTIONAL
 	static
@@ -1153,6 +1492,28 @@ struct startTask : public startTaskT<OS_STACK_SIZE>
 	startTask( const unsigned _prio, FUN_t _state ): startTaskT<OS_STACK_SIZE>(_prio, _state) {}
 };
 
+/******************************************************************************
+ *
+ * Class             : TaskSRP
+ *
+ * Description       : create and initialize run-to-completion task object, which uses the shared stack
+ *
+ * Constructor parameters
+ *   prio            : preemption level of the task (task priority)
+ *   state           : task state (task function), executed once after every start of the task
+ *
+ * Note              : available only when OS_SRP_STACK is set
+ *
+ ******************************************************************************/
+
+#if OS_SRP_STACK
+struct TaskSRP : public baseTask
+{
+	explicit
+	TaskSRP( const unsigned _prio, FUN_t _state ): baseTask(_prio, _state, SRP_STK, OS_SRP_STACK) {}
+};
+#endif
+
 /******************************************************************************
  *
  * Namespace         : ThisTask
@@ -1165,6 +1526,8 @@ namespace ThisTask
 {
 	static inline void     pass      ( void )                          {        tsk_pass      ();                         }
 	static inline void     yield     ( void )                          {        tsk_yield     ();                         }
+	static inline void     lock      ( void )                          {        tsk_lock      ();                         }
+	static inline void     unlock    ( void )                          {        tsk_unlock    ();                         }
 #if OS_FUNCTIONAL
 	static inline void     flip      ( FUN_t    _state )               {        ((baseTask *) System.cur)->fun_ = _state;
 	                                                                            tsk_flip      (baseTask::run_);           }
@@ -1176,6 +1539,8 @@ namespace ThisTask
 	static inline void     setPrio   ( unsigned _prio )                {        tsk_setPrio   (_prio);                    }
 	static inline unsigned getPrio   ( void )                          { return tsk_getPrio   ();                         }
 	static inline unsigned prio      ( void )                          { return tsk_getPrio   ();                         }
+	static inline unsigned srpLock   ( unsigned _ceiling )             { return srp_lock      (_ceiling);                 }
+	static inline void     srpUnlock ( unsigned _prio )                {        srp_unlock    (_prio);                    }
 
 	static inline void     kill      ( void )                          {        tsk_kill      (System.cur);               }
 	static inline unsigned detach    ( void )                          { return tsk_detach    (System.cur);               }
@@ -52,7 +52,14 @@ struct __tmr
 	fun_t  * state; // callback procedure
 	cnt_t    start;
 	cnt_t    delay;
+#if OS_TIMER_WHEEL
+	tmr_t ** whl;   // slot of the timing wheel holding the timer, 0 if the timer is in the WAIT queue
+#endif
 	cnt_t    period;
+#if OS_TIMER_TASK
+	bool     isr;   // callback procedure is launched in the interrupt context
+	unsigned gen;   // incremented by every start and stop, cancels the expiration pending in the timer service task
+#endif
 };
 
 /******************************************************************************
@@ -71,7 +78,19 @@ struct __tmr
  *
  ******************************************************************************/
 
-#define               _TMR_INIT( _state ) { _OBJ_INIT(), 0, _state, 0, 0, 0 }
+#if OS_TIMER_WHEEL
+#define               _TMR_WHL  0,
+#else
+#define               _TMR_WHL
+#endif
+
+#if OS_TIMER_TASK
+#define               _TMR_ISR  , 0, 0
+#else
+#define               _TMR_ISR
+#endif
+
+#define               _TMR_INIT( _state ) { _OBJ_INIT(), 0, _state, 0, 0, _TMR_WHL 0 _TMR_ISR }
 
 /******************************************************************************
  *
@@ -301,8 +320,13 @@ struct __tmr
  *
  ******************************************************************************/
 
+#if OS_TIMER_TASK
+__STATIC_INLINE
+tmr_t *tmr_thisISR( void ) { return System.tmr; }
+#else
 __STATIC_INLINE
 tmr_t *tmr_thisISR( void ) { return (tmr_t *) WAIT.obj.next; }
+#endif
 
 /******************************************************************************
  *
@@ -635,6 +659,31 @@ void tmr_flipISR( fun_t *proc ) { tmr_thisISR()->state = proc; }
 __STATIC_INLINE
 void tmr_delayISR( cnt_t delay ) { tmr_thisISR()->delay = delay; }
 
+/******************************************************************************
+ *
+ * Name              : tmr_setISR
+ *
+ * Description       : declare whether the timer callback procedure is launched in the interrupt context
+ *
+ * Parameters
+ *   tmr             : pointer to timer object
+ *   isr             : false: callback procedure is launched by the timer service task with the interrupts enabled (default)
+ *                     true:  callback procedure is launched in the system timer interrupt with the interrupts masked
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     available only when OS_TIMER_TASK is set
+ *                     callback procedure launched by the timer service task should not wait for any object,
+ *                     because it delays the callbacks of all other timers
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_TASK
+__STATIC_INLINE
+void tmr_setISR( tmr_t *tmr, bool isr ) { tmr->isr = isr; }
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -686,11 +735,14 @@ struct Timer : public __tmr
 	unsigned wait     ( void )                                      { return tmr_wait         (this);                          }
 	unsigned take     ( void )                                      { return tmr_take         (this);                          }
 	unsigned takeISR  ( void )                                      { return tmr_takeISR      (this);                          }
+#if OS_TIMER_TASK
+	void     setISR   ( bool _isr )                                 {        tmr_setISR       (this, _isr);                    }
+#endif
 
 	bool     operator!( void )                                      { return __tmr::id == ID_STOPPED;                          }
 #if OS_FUNCTIONAL
 	static
-	void     run_( void ) { ((Timer *) WAIT.obj.next)->fun_(); }
+	void     run_( void ) { ((Timer *) tmr_thisISR())->fun_(); }
 	FUN_t    fun_;
 #endif
 };
@@ -801,7 +853,7 @@ struct startTimerPeriodic : public startTimer
 namespace ThisTimer
 {
 #if OS_FUNCTIONAL
-	static inline void flipISR ( FUN_t _state ) { ((Timer *) WAIT.obj.next)->fun_ = _state;
+	static inline void flipISR ( FUN_t _state ) { ((Timer *) tmr_thisISR())->fun_ = _state;
 	                                              tmr_flipISR (Timer::run_);                }
 #else
 	static inline void flipISR ( FUN_t _state ) { tmr_flipISR (_state);                     }
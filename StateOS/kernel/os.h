@@ -41,12 +41,15 @@
 #include "inc/ossemaphore.h"
 #include "inc/osmutex.h"
 #include "inc/osfastmutex.h"
+#include "inc/osceilingmutex.h"
 #include "inc/osconditionvariable.h"
 #include "inc/oslist.h"
 #include "inc/osmemorypool.h"
 #include "inc/osstreambuffer.h"
 #include "inc/osmessagebuffer.h"
 #include "inc/osmailboxqueue.h"
+#include "inc/ospriorityqueue.h"
+#include "inc/osringbuffer.h"
 #include "inc/osjobqueue.h"
 #include "inc/oseventqueue.h"
 #include "inc/ostimer.h"
@@ -111,6 +114,26 @@ void *sys_alloc( size_t size ) { return core_sys_alloc(size); }
 __STATIC_INLINE
 void sys_free( void *ptr ) { core_sys_free(ptr); }
 
+/******************************************************************************
+ *
+ * Name              : sys_heapStat
+ *
+ * Description       : get statistics of the system heap
+ *
+ * Parameters
+ *   hst             : pointer to structure to store statistics:
+ *                     free space, size of the largest free memory segment and high-water mark of the used space (in bytes)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     all values are zero when the system heap is not used (OS_HEAP_SIZE == 0)
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void sys_heapStat( hst_t *hst ) { core_sys_stat(hst); }
+
 /******************************************************************************
  *
  * Name              : sys_lock
@@ -123,6 +146,7 @@ void sys_free( void *ptr ) { core_sys_free(ptr); }
  * Return            : none
  *
  * Note              : may be used both in thread and handler mode
+ *                     to prevent only the preemption of the current task, use tsk_lock
  *
  ******************************************************************************/
 
@@ -2,7 +2,7 @@
 
     @file    StateOS: osalloc.c
     @author  Rajmund Szymanski
-    @date    07.05.2018
+    @date    13.06.2018
     @brief   This file provides set of variables and functions for StateOS.
 
  ******************************************************************************
@@ -35,7 +35,296 @@
 // SYSTEM ALLOC/FREE SERVICES
 /* -------------------------------------------------------------------------- */
 
-#if OS_HEAP_SIZE
+#if OS_HEAP_SIZE && OS_HEAP_TLSF
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct __hdr hdr_t;
+
+struct __hdr
+{
+	hdr_t  * prev;   // physically previous memory segment
+	size_t   size;   // size of the memory segment (in hdr_t units) << 1, the lowest bit is set when the segment is free
+};
+
+typedef struct __seg seg_t;
+
+struct __seg
+{
+	hdr_t    hdr;
+	seg_t  * next;   // next free memory segment in the segregated list
+	seg_t  * back;   // previous free memory segment in the segregated list
+};
+
+/* -------------------------------------------------------------------------- */
+
+#define HSIZE( size ) \
+ ALIGNED_SIZE( size, hdr_t )
+
+#define LOG2_2( x )  (((x) & 0x00000002UL) ?  1 : 0)
+#define LOG2_4( x )  (((x) & 0x0000000CUL) ?  2 + LOG2_2 ((x) >>  2) : LOG2_2 (x))
+#define LOG2_8( x )  (((x) & 0x000000F0UL) ?  4 + LOG2_4 ((x) >>  4) : LOG2_4 (x))
+#define LOG2_16( x ) (((x) & 0x0000FF00UL) ?  8 + LOG2_8 ((x) >>  8) : LOG2_8 (x))
+#define LOG2_32( x ) (((x) & 0xFFFF0000UL) ? 16 + LOG2_16((x) >> 16) : LOG2_16(x))
+
+#define MIN_SIZE      (sizeof(seg_t) / sizeof(hdr_t))
+#define MAX_SIZE      (HSIZE(OS_HEAP_SIZE))
+#define SL_BITS       3
+#define SL_SIZE       (1U << SL_BITS)
+#define FL_SIZE       (LOG2_32(MAX_SIZE) < SL_BITS ? 1 : LOG2_32(MAX_SIZE) - SL_BITS + 2)
+
+/* -------------------------------------------------------------------------- */
+
+static
+hdr_t Heap[MAX_SIZE+1];
+
+static
+struct
+{
+	unsigned map;                    // first-level bitmap
+	unsigned sub[FL_SIZE];           // second-level bitmaps
+	seg_t  * lst[FL_SIZE][SL_SIZE];  // segregated lists of free memory segments
+	size_t   free;                   // free space (in hdr_t units)
+	size_t   peak;                   // high-water mark of the used space (in hdr_t units)
+}	Tlsf;
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_fls( size_t size )
+{
+	return 31 - __CLZ((uint32_t)size);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_ffs( unsigned map )
+{
+	return 31 - __CLZ(map & -map);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_seg_index( size_t size, unsigned *fl, unsigned *sl )
+{
+	unsigned f;
+
+	if (size < SL_SIZE)
+	{
+		*fl = 0;
+		*sl = size;
+	}
+	else
+	{
+		f   = priv_fls(size);
+		*fl = f - SL_BITS + 1;
+		*sl = (size >> (f - SL_BITS)) - SL_SIZE;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_seg_insert( seg_t *seg )
+{
+	unsigned fl, sl;
+
+	priv_seg_index(seg->hdr.size >> 1, &fl, &sl);
+
+	seg->hdr.size |= 1;
+	seg->back = 0;
+	seg->next = Tlsf.lst[fl][sl];
+	if (seg->next)
+		seg->next->back = seg;
+	Tlsf.lst[fl][sl] = seg;
+
+	Tlsf.map     |= 1U << fl;
+	Tlsf.sub[fl] |= 1U << sl;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_seg_remove( seg_t *seg )
+{
+	unsigned fl, sl;
+
+	priv_seg_index(seg->hdr.size >> 1, &fl, &sl);
+
+	seg->hdr.size &= ~(size_t)1;
+	if (seg->next)
+		seg->next->back = seg->back;
+	if (seg->back)
+		seg->back->next = seg->next;
+	else
+	if ((Tlsf.lst[fl][sl] = seg->next) == 0)
+		if ((Tlsf.sub[fl] &= ~(1U << sl)) == 0)
+			Tlsf.map &= ~(1U << fl);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+seg_t *priv_seg_search( size_t size )
+{
+	unsigned fl, sl;
+	unsigned map;
+
+	if (size >= SL_SIZE)                 // round up to the next segregated list, so that any segment found fits
+		size += (1U << (priv_fls(size) - SL_BITS)) - 1;
+
+	priv_seg_index(size, &fl, &sl);
+
+	if (fl >= FL_SIZE)
+		return 0;
+
+	map = Tlsf.sub[fl] & (~0U << sl);
+	if (map == 0)
+	{
+		map = (fl + 1 < FL_SIZE) ? Tlsf.map & (~0U << (fl + 1)) : 0;
+		if (map == 0)
+			return 0;
+		fl = priv_ffs(map);
+		map = Tlsf.sub[fl];
+	}
+	sl = priv_ffs(map);
+
+	return Tlsf.lst[fl][sl];
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+hdr_t *priv_seg_after( hdr_t *hdr )
+{
+	return hdr + (hdr->size >> 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *core_sys_alloc( size_t size )
+{
+	seg_t *seg;
+	hdr_t *nxt;
+	size_t rem;
+
+	assert(HSIZE(size));
+
+	size = HSIZE(size) + 1;
+
+	port_sys_lock();
+
+	if (Heap[MAX_SIZE].prev == 0)        // the heap has not been initialized yet
+	{
+		Heap[0].size = MAX_SIZE << 1;
+		Heap[MAX_SIZE].prev = Heap;      // the sentinel segment is never free
+		Tlsf.free = MAX_SIZE;
+		priv_seg_insert((seg_t *) Heap);
+	}
+
+	seg = priv_seg_search(size);
+
+	if (seg)
+	{
+		priv_seg_remove(seg);
+
+		rem = (seg->hdr.size >> 1) - size;
+		if (rem >= MIN_SIZE)             // memory segment is larger than required
+		{
+			nxt = (hdr_t *) seg + size;
+			nxt->prev = &seg->hdr;
+			nxt->size = rem << 1;
+			priv_seg_after(nxt)->prev = nxt;
+			seg->hdr.size = size << 1;
+			priv_seg_insert((seg_t *) nxt);
+		}
+
+		Tlsf.free -= seg->hdr.size >> 1;
+		if (Tlsf.peak < MAX_SIZE - Tlsf.free)
+			Tlsf.peak = MAX_SIZE - Tlsf.free;
+
+		seg = memset(&seg->hdr + 1, 0, ((seg->hdr.size >> 1) - 1) * sizeof(hdr_t));
+	}
+
+	port_sys_unlock();
+
+	assert(seg);
+
+	return seg;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_sys_free( void *base )
+{
+	hdr_t *hdr;
+	hdr_t *nxt;
+
+	if (base == 0)
+		return;
+
+	hdr = (hdr_t *) base - 1;
+
+	port_sys_lock();
+
+	assert((hdr->size & 1) == 0);
+
+	Tlsf.free += hdr->size >> 1;
+
+	nxt = priv_seg_after(hdr);
+	if (nxt->size & 1)                   // merge with the next free memory segment
+	{
+		priv_seg_remove((seg_t *) nxt);
+		hdr->size += nxt->size;
+	}
+
+	nxt = hdr->prev;
+	if (nxt && (nxt->size & 1))          // merge with the previous free memory segment
+	{
+		priv_seg_remove((seg_t *) nxt);
+		nxt->size += hdr->size;
+		hdr = nxt;
+	}
+
+	priv_seg_after(hdr)->prev = hdr;
+	priv_seg_insert((seg_t *) hdr);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_sys_stat( hst_t *hst )
+{
+	seg_t *seg;
+	size_t max = 0;
+
+	port_sys_lock();
+
+	if (Tlsf.map)                        // the largest segment is in the highest non-empty segregated list
+	{
+		unsigned fl = priv_fls(Tlsf.map);
+		unsigned sl = priv_fls(Tlsf.sub[fl]);
+		for (seg = Tlsf.lst[fl][sl]; seg; seg = seg->next)
+			if (max < (seg->hdr.size >> 1) - 1)
+				max = (seg->hdr.size >> 1) - 1;
+	}
+	else
+	if (Heap[MAX_SIZE].prev == 0)        // the heap has not been initialized yet
+		max = MAX_SIZE - 1;
+
+	hst->free    = (Heap[MAX_SIZE].prev ? Tlsf.free : MAX_SIZE) * sizeof(hdr_t);
+	hst->largest = max * sizeof(hdr_t);
+	hst->peak    = Tlsf.peak * sizeof(hdr_t);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#elif OS_HEAP_SIZE
 
 /* -------------------------------------------------------------------------- */
 
@@ -58,6 +347,9 @@ static
 hdr_t Heap[HSIZE(OS_HEAP_SIZE)+1] =
   { { Heap+HSIZE(OS_HEAP_SIZE), HSIZE(OS_HEAP_SIZE) } };
 
+static
+size_t Used, Peak; // used space and its high-water mark (in hdr_t units)
+
 /* -------------------------------------------------------------------------- */
 
 void *core_sys_alloc( size_t size )
@@ -95,6 +387,9 @@ void *core_sys_alloc( size_t size )
 		heap = memset(heap, 0, size * sizeof(hdr_t));
 		heap->next = next;
 		heap = heap + 1;
+		Used += size;
+		if (Peak < Used)
+			Peak = Used;
 		break;								// memory segment was successfully allocated
 	}
 
@@ -121,6 +416,7 @@ void core_sys_free( void *base )
 			continue;
 
 		heap->size = heap->next - heap;
+		Used -= heap->size;
 		break;								// memory segment was successfully released
 	}
 
@@ -129,6 +425,36 @@ void core_sys_free( void *base )
 
 /* -------------------------------------------------------------------------- */
 
+void core_sys_stat( hst_t *hst )
+{
+	hdr_t *heap;
+	size_t size = 0;
+	size_t max  = 0;
+
+	port_sys_lock();
+
+	hst->free = 0;
+
+	for (heap = Heap; heap; heap = heap->next)
+	{
+		if (heap->size == 0)				// memory segment has already been allocated
+			size = 0;
+		else								// adjacent free memory segments will be merged
+			hst->free += heap->size * sizeof(hdr_t);
+
+		size += heap->size;
+		if (max < size)
+			max = size;
+	}
+
+	hst->largest = max ? (max - 1) * sizeof(hdr_t) : 0;
+	hst->peak    = Peak * sizeof(hdr_t);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
 #else
 
 void *core_sys_alloc( size_t size )
@@ -154,6 +480,13 @@ void core_sys_free( void *base )
 	free(base);
 }
 
+/* -------------------------------------------------------------------------- */
+
+void core_sys_stat( hst_t *hst )
+{
+	memset(hst, 0, sizeof(hst_t)); // statistics of the compiler's heap are not available
+}
+
 #endif
 
 /* -------------------------------------------------------------------------- */
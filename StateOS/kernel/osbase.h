@@ -47,6 +47,84 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#ifndef OS_HEAP_TLSF
+#define OS_HEAP_TLSF      0 /* system heap uses first-fit allocator */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TIMER_WHEEL
+#define OS_TIMER_WHEEL    0 /* timers' READY queue is a sorted list */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_PRIO_LEVELS
+#define OS_PRIO_LEVELS    0 /* tasks' READY queue is a sorted list */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TIMER_TASK
+#define OS_TIMER_TASK     0 /* timers' callback procedures are launched in the interrupt context */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TICK_SUPPRESS
+#define OS_TICK_SUPPRESS  0 /* system timer interrupts are not suppressed in the idle task */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TASK_STATS
+#define OS_TASK_STATS     0 /* tasks' run-time statistics are not collected */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_MEM_COMPACT
+#define OS_MEM_COMPACT    0 /* memory pool objects keep the header of the list */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_FLAG_INDEX
+#define OS_FLAG_INDEX     0 /* all tasks waiting for the flag object are kept in a single queue */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TRACE
+#define OS_TRACE          0 /* kernel events are not recorded */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_PAINT
+#define OS_STACK_PAINT    0 /* tasks' stacks are not painted (except in the DEBUG mode) */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_CHECK
+#define OS_STACK_CHECK    0 /* idle task does not check tasks' stacks */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_GUARD
+#define OS_STACK_GUARD    0 /* tasks' stacks are not protected by the MPU guard region */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_SRP_STACK
+#define OS_SRP_STACK      0 /* run-to-completion tasks sharing the stack are not available */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #if     OS_TIMER_SIZE == 16
 typedef uint16_t     cnt_t;
 #define CNT_MAX          0xFFFFU
@@ -71,6 +149,7 @@ typedef uint64_t     cnt_t;
 typedef struct __tmr tmr_t, * const tmr_id; // timer
 typedef struct __tsk tsk_t, * const tsk_id; // task
 typedef         void fun_t(); // timer/task procedure
+typedef         void act_t( void * ); // job procedure with an argument
 
 /* -------------------------------------------------------------------------- */
 
@@ -90,6 +169,21 @@ struct __obj
 
 /* -------------------------------------------------------------------------- */
 
+// job data
+
+typedef struct __jbd jbd_t;
+
+struct __jbd
+{
+	act_t  * act;   // job procedure with an argument (0 if the job procedure takes no arguments)
+	union  {
+	fun_t  * fun;   // job procedure without arguments
+	void   * arg;   // argument of job procedure 'act'
+	}        par;
+};
+
+/* -------------------------------------------------------------------------- */
+
 // system data
 
 typedef struct __sys sys_t;
@@ -97,10 +191,18 @@ typedef struct __sys sys_t;
 struct __sys
 {
 	tsk_t  * cur;   // pointer to the current task control block
+	unsigned lock;  // scheduler lock counter, the current task is not preempted while it is non-zero
+	unsigned pend;  // a context switch was deferred while the scheduler was locked
 #if HW_TIMER_SIZE < OS_TIMER_SIZE
 	volatile
 	cnt_t    cnt;   // system timer counter
 #endif
+#if OS_TASK_STATS
+	tsk_t  * yld;   // task that gave up the processor voluntarily
+#endif
+#if OS_TIMER_TASK
+	tmr_t  * tmr;   // timer whose callback procedure is running
+#endif
 };
 
 /* -------------------------------------------------------------------------- */
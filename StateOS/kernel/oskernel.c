@@ -37,10 +37,86 @@
 // SYSTEM INTERNAL SERVICES
 /* -------------------------------------------------------------------------- */
 
+#if     OS_STACK_CHECK && !OS_STACK_PAINT
+#error  osconfig.h: OS_STACK_CHECK requires OS_STACK_PAINT to be set!
+#endif
+
+#if OS_STACK_CHECK
+
+static
+tsk_t *priv_stk_task( unsigned num )
+{
+	tsk_t *tsk;
+	tmr_t *tmr;
+
+	for (tsk = IDLE.obj.next; tsk != &IDLE; tsk = tsk->obj.next)
+		if (num-- == 0)
+			return tsk;                        // tasks in the READY queue
+	for (tmr = core_tmr_next(&WAIT); tmr != &WAIT; tmr = core_tmr_next(tmr))
+		if (tmr->id == ID_DELAYED && num-- == 0)
+			return (tsk_t *)tmr;               // waiting and suspended tasks
+
+	return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// every run of the idle task scans the stack of a single task,
+// so the interrupts are never masked for more than one stack scan
+
+static
+void priv_stk_check( void )
+{
+	static
+	cnt_t    time = 0;
+	static
+	unsigned num  = 0; // number of the next task to scan in the current round
+	tsk_t   *tsk;
+
+	if (num == 0 && (cnt_t)(core_sys_time() - time) < (cnt_t)(OS_STACK_CHECK))
+		return;
+
+	port_sys_lock();
+
+	if (num == 0)
+		time = core_sys_time();
+
+	tsk = priv_stk_task(num);
+	if (tsk)
+	{
+		core_stk_scan(tsk);
+		num++;
+	}
+	else
+		num = 0;                               // the round is complete
+
+	port_sys_unlock();
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 static
 void priv_tsk_idle( void )
 {
+#if OS_STACK_CHECK
+	priv_stk_check();
+#endif
+#if OS_TICK_SUPPRESS && HW_TIMER_SIZE == 0
+	cnt_t delay;
+
+	__disable_irq(); // BASEPRI would prevent the masked interrupts from waking up the processor
+
+	if (IDLE.obj.next == &IDLE && (delay = core_tmr_delay()) > 1)
+		System.cnt += port_sys_sleep(delay);
+	else
+		__WFI();
+
+	__enable_irq();
+#else
 	__WFI();
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -76,6 +152,8 @@ tmr_t WAIT = { .obj={ .prev=&WAIT, .next=&WAIT }, .id=ID_TIMER, .delay=INFINITE
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TIMER_WHEEL == 0
+
 static
 void priv_tmr_insert( tmr_t *tmr, unsigned id )
 {
@@ -99,6 +177,346 @@ void priv_tmr_remove( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
+cnt_t core_tmr_delay( void )
+{
+	tmr_t *tmr = WAIT.obj.next;
+	cnt_t  time;
+
+	if (tmr->delay == INFINITE)
+	return INFINITE; // return if no timer is counting
+
+	time = (cnt_t)(core_sys_time() - tmr->start);
+
+	if (tmr->delay <= time)
+	return 0; // return if timer finished counting
+
+	return (cnt_t)(tmr->delay - time);
+}
+
+/* -------------------------------------------------------------------------- */
+
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	return tmr->obj.next;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_TIMER_WHEEL
+
+/* -------------------------------------------------------------------------- */
+
+// The timers' READY queue (WAIT) holds only timers that have finished counting,
+// in the order of their deadlines. Timers still counting are kept in the slots
+// of a hierarchical timing wheel; timers counting indefinitely are kept in a
+// separate ring. Every slot is a circular list without a sentinel, so a timer
+// is removed from any of them in constant time. The timer records the slot it
+// was linked to, because its deadline may change while it is counting.
+
+#define WHL_BITS    4
+#define WHL_SLOTS  (1U<<(WHL_BITS))
+#define WHL_MASK   ((WHL_SLOTS)-1)
+#define WHL_LEVELS ((OS_TIMER_SIZE)/(WHL_BITS))
+#define WHL_BIT(i) (1U<<((WHL_SLOTS)-1-(i)))
+#define WHL_ALL   ((1U<<(WHL_SLOTS))-1)
+
+static struct
+{
+	cnt_t    time; // the first tick not yet processed by the wheel
+	unsigned map[WHL_LEVELS]; // bitmaps of not empty slots, slot 0 is the most significant bit
+	tmr_t  * slot[WHL_LEVELS*WHL_SLOTS]; // first timers of slots
+	tmr_t  * inf;  // first timer counting indefinitely
+}	Wheel;
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_link( tmr_t **head, tmr_t *tmr )
+{
+	tmr->whl = head;
+
+	if (*head)
+	{
+		priv_rdy_insert(&tmr->obj, &(*head)->obj);
+	}
+	else
+	{
+		tmr->obj.prev = tmr;
+		tmr->obj.next = tmr;
+		*head = tmr;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_insert( tmr_t *tmr )
+{
+	cnt_t    time = (cnt_t)(tmr->start + tmr->delay);
+	cnt_t    dist = (cnt_t)(time - Wheel.time);
+	unsigned lvl  = 0;
+	unsigned idx;
+
+	while (dist >= WHL_SLOTS)
+	{
+		dist >>= WHL_BITS;
+		lvl++;
+	}
+
+	idx = (unsigned)(time >> (lvl*WHL_BITS)) & WHL_MASK;
+
+	priv_whl_link(&Wheel.slot[lvl*WHL_SLOTS+idx], tmr);
+	Wheel.map[lvl] |= WHL_BIT(idx);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_cascade( unsigned lvl, unsigned idx )
+{
+	tmr_t *tmr = Wheel.slot[lvl*WHL_SLOTS+idx];
+	tmr_t *nxt;
+	tmr_t *end;
+
+	if (tmr == 0)
+		return;
+
+	Wheel.slot[lvl*WHL_SLOTS+idx] = 0;
+	Wheel.map[lvl] &= ~WHL_BIT(idx);
+
+	for (end = tmr; tmr; tmr = nxt)
+	{
+		nxt = tmr->obj.next;
+		if (nxt == end)
+			nxt = 0;
+
+		if (lvl)
+			priv_whl_insert(tmr);
+		else
+		{
+			tmr->whl = 0;
+			priv_rdy_insert(&tmr->obj, &WAIT.obj);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_tick( void )
+{
+	unsigned lvl = 0;
+
+	while (lvl < WHL_LEVELS-1 && ((Wheel.time >> (lvl*WHL_BITS)) & WHL_MASK) == 0)
+		lvl++;
+
+	for (;;)
+	{
+		priv_whl_cascade(lvl, (unsigned)(Wheel.time >> (lvl*WHL_BITS)) & WHL_MASK);
+		if (lvl-- == 0)
+			break;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool priv_whl_next( cnt_t *dist )
+{
+	bool     found = false;
+	unsigned lvl, map, idx;
+	cnt_t    time;
+
+	for (lvl = 0; lvl < WHL_LEVELS; lvl++)
+	{
+		map = Wheel.map[lvl];
+		if (map == 0)
+			continue;
+
+		time = (cnt_t)((cnt_t)(Wheel.time - 1) >> (lvl*WHL_BITS)) + 1;
+		idx  = (unsigned)time & WHL_MASK;
+		map  = ((map << idx) | (map >> (WHL_SLOTS - idx))) & WHL_ALL;
+		time = (cnt_t)(time + __CLZ(map) - (32 - WHL_SLOTS)) << (lvl*WHL_BITS);
+		time = (cnt_t)(time - Wheel.time);
+
+		if (!found || time < *dist)
+			*dist = time;
+		found = true;
+	}
+
+	return found;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_whl_update( void )
+{
+	cnt_t lag = (cnt_t)(core_sys_time() - Wheel.time + 1);
+	cnt_t dist;
+
+	while (lag > 0 && priv_whl_next(&dist) && dist < lag)
+	{
+		Wheel.time += dist;
+		priv_whl_tick();
+		Wheel.time += 1;
+		lag -= dist + 1;
+	}
+
+	Wheel.time += lag;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_insert( tmr_t *tmr, unsigned id )
+{
+	tmr_t *nxt = &WAIT;
+	tmr->id = id;
+
+	if (tmr->delay == INFINITE)
+	{
+		priv_whl_link(&Wheel.inf, tmr);
+		return;
+	}
+
+	priv_whl_update();
+
+	if (tmr->delay >= (cnt_t)(Wheel.time - tmr->start))
+	{
+		priv_whl_insert(tmr);
+		return;
+	}
+
+	tmr->whl = 0;
+
+	do nxt = nxt->obj.next;
+	while (nxt->delay < (cnt_t)(tmr->start + tmr->delay - nxt->start));
+
+	priv_rdy_insert(&tmr->obj, &nxt->obj);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_remove( tmr_t *tmr )
+{
+	tmr_t  **head = tmr->whl;
+	unsigned pos;
+
+	priv_rdy_remove(&tmr->obj);
+	tmr->whl = 0;
+
+	if (head == 0 || *head != tmr) // the timer is in the WAIT queue or it is not the first one in its slot
+		return;
+
+	if (tmr->obj.next != tmr)
+		*head = tmr->obj.next;
+	else
+	{
+		*head = 0;
+		if (head != &Wheel.inf)
+		{
+			pos = (unsigned)(head - Wheel.slot);
+			Wheel.map[pos / WHL_SLOTS] &= ~WHL_BIT(pos % WHL_SLOTS);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+tmr_t *priv_tmr_expired( void )
+{
+#if HW_TIMER_SIZE
+	cnt_t dist;
+
+	for (;;)
+	{
+		priv_whl_update();
+
+		if (WAIT.obj.next != &WAIT)
+		return WAIT.obj.next; // return the first timer that finished counting
+
+		port_tmr_stop();
+
+		if (!priv_whl_next(&dist))
+		return 0; // return if no timer is counting
+
+		port_tmr_start((cnt_t)(Wheel.time + dist));
+
+		if (dist >= (cnt_t)(core_sys_time() - Wheel.time + 1))
+		return 0; // return if the next event of the wheel is still ahead
+
+		port_tmr_stop();
+	}
+#else
+	priv_whl_update();
+
+	if (WAIT.obj.next != &WAIT)
+	return WAIT.obj.next; // return the first timer that finished counting
+
+	return 0;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	tmr_t  **head = Wheel.slot;
+	tmr_t   *nxt  = tmr->obj.next;
+
+	if (tmr->whl == 0) // the WAIT queue
+	{
+		if (nxt != &WAIT)
+			return nxt;
+		if (Wheel.inf)
+			return Wheel.inf;
+	}
+	else
+	if (tmr->whl == &Wheel.inf)
+	{
+		if (nxt != Wheel.inf)
+			return nxt;
+	}
+	else
+	{
+		if (nxt != *tmr->whl)
+			return nxt;
+		head = tmr->whl + 1;
+	}
+
+	for (; head < Wheel.slot+WHL_LEVELS*WHL_SLOTS; head++)
+		if (*head)
+			return *head;
+
+	return &WAIT;
+}
+
+/* -------------------------------------------------------------------------- */
+
+cnt_t core_tmr_delay( void )
+{
+	cnt_t dist;
+
+	priv_whl_update();
+
+	if (WAIT.obj.next != &WAIT)
+	return 0; // return if timer finished counting
+
+	if (!priv_whl_next(&dist))
+	return INFINITE; // return if no timer is counting
+
+	return (cnt_t)(dist + 1); // the wheel has already processed the current tick
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_TIMER_WHEEL
+
+/* -------------------------------------------------------------------------- */
+
 void core_tmr_insert( tmr_t *tmr, unsigned id )
 {
 	priv_tmr_insert(tmr, id);
@@ -115,7 +533,7 @@ void core_tmr_remove( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
-#if HW_TIMER_SIZE
+#if OS_TIMER_WHEEL == 0 && HW_TIMER_SIZE
 
 static
 bool priv_tmr_expired( tmr_t *tmr )
@@ -140,7 +558,7 @@ bool priv_tmr_expired( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
-#else
+#elif OS_TIMER_WHEEL == 0
 
 static
 bool priv_tmr_expired( tmr_t *tmr )
@@ -155,17 +573,65 @@ bool priv_tmr_expired( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TIMER_TASK
+
+#if     OS_PRIO_LEVELS && OS_TIMER_TASK >= OS_PRIO_LEVELS
+#error  osconfig.h: Incorrect OS_TIMER_TASK value! Must be less then OS_PRIO_LEVELS.
+#endif
+
+static  tmr_t PEND = { .obj={ .prev=&PEND, .next=&PEND }, .id=ID_TIMER }; // timers waiting for the timer service task
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool priv_tmr_reload( tmr_t *tmr )
+{
+	cnt_t time = (cnt_t)(core_sys_time() - tmr->start);
+
+	if (tmr->period != 0 && tmr->delay == tmr->period && tmr->delay <= time)
+		tmr->start += time - time % tmr->period; // periodic timer late by a whole period or more, skip the missed expirations
+
+	return tmr->delay >= (cnt_t)(core_sys_time() - tmr->start + 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
 static
 void priv_tmr_wakeup( tmr_t *tmr, unsigned event )
 {
+#if OS_TIMER_TASK
+	tmr_t *prv;
+#endif
+	core_trc_event(TRC_TIMER, 0, tmr, 0);
+
 	tmr->start += tmr->delay;
 	tmr->delay  = tmr->period;
 
+#if OS_TIMER_TASK
+	if (tmr->state && !tmr->isr)
+	{
+		priv_tmr_remove(tmr);                  // the timer stays in the ID_TIMER state
+		priv_rdy_insert(&tmr->obj, &PEND.obj); // until the timer service task completes its expiration
+		core_one_wakeup(&PEND, event);
+		return;
+	}
+
 	if (tmr->state)
+	{
+		prv = System.tmr;                      // the interrupt can preempt the timer service task
+		System.tmr = tmr;
 		tmr->state();
+		System.tmr = prv;
+	}
+#else
+	if (tmr->state)
+		tmr->state();
+#endif
 
 	core_tmr_remove(tmr);
-	if (tmr->delay >= (cnt_t)(core_sys_time() - tmr->start + 1))
+	if (priv_tmr_reload(tmr))
 		priv_tmr_insert(tmr, ID_TIMER);
 
 	core_all_wakeup(tmr, event);
@@ -181,7 +647,11 @@ void core_tmr_handler( void )
 
 	port_isr_lock();
 
+#if OS_TIMER_WHEEL
+	while ((tmr = priv_tmr_expired()) != 0)
+#else
 	while (priv_tmr_expired(tmr = WAIT.obj.next))
+#endif
 	{
 		if (tmr->id == ID_TIMER)
 			priv_tmr_wakeup((tmr_t *)tmr, E_SUCCESS);
@@ -193,6 +663,63 @@ void core_tmr_handler( void )
 	port_isr_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_TASK
+
+static
+void priv_tmr_service( void )
+{
+	tmr_t  *tmr;
+	fun_t  *state;
+	unsigned gen;
+
+	port_sys_lock();
+
+	while ((tmr = PEND.obj.next) == &PEND)
+		core_tsk_waitFor(&PEND, INFINITE);
+
+	System.tmr = tmr;
+	state = tmr->state;
+	gen = tmr->gen;
+
+	port_sys_unlock();
+
+	if (state)
+		state();
+
+	port_sys_lock();
+
+	System.tmr = 0;
+
+	if (tmr->gen == gen) // the timer has not been stopped or restarted in the meantime
+	{
+		core_tmr_remove(tmr);
+		if (priv_tmr_reload(tmr))
+			core_tmr_insert(tmr, ID_TIMER);
+
+		core_all_wakeup(tmr, E_SUCCESS);
+	}
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static  stk_t TMR_STK[SSIZE(OS_STACK_SIZE)];
+static  tsk_t TMR_TSK = _TSK_INIT(OS_TIMER_TASK, priv_tmr_service, TMR_STK, OS_STACK_SIZE); // timer service task
+
+void core_tmr_service( void )
+{
+	if (TMR_TSK.id == ID_STOPPED)
+	{
+		core_ctx_init(&TMR_TSK);
+		core_tsk_insert(&TMR_TSK);
+	}
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 // SYSTEM TASK SERVICES
 /* -------------------------------------------------------------------------- */
@@ -216,6 +743,63 @@ sys_t System = { .cur=&MAIN };
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_SRP_STACK
+
+// Run-to-completion tasks do not wait and they are preempted only by tasks
+// of higher priority, so they are started and completed in the LIFO order.
+// Every task started on the shared stack is placed below the context of the
+// last started one, which cannot be resumed until the new task completes.
+
+stk_t SRP_STK[SSIZE(OS_SRP_STACK)]; // stack shared by run-to-completion tasks
+
+static
+tsk_t *Srp; // the last run-to-completion task started on the shared stack
+
+#if OS_STACK_PAINT
+static
+stk_t *SrpMark; // high-water mark of the shared stack, painted before the first run-to-completion task is started
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_srp_start( tsk_t *tsk )
+{
+	if (Srp)
+		tsk->top = (stk_t *) LIMITED(port_ctx_below(Srp->sp), stk_t);
+	else
+		tsk->top = SRP_STK + SSIZE(OS_SRP_STACK);
+
+	tsk->srp = Srp;
+	Srp = tsk;
+
+	tsk->sp = (ctx_t *)tsk->top - 1;
+	assert((size_t)tsk->sp > (size_t)tsk->stack); // the shared stack is too small
+	port_ctx_init(tsk->sp, core_tsk_loop);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_srp_remove( tsk_t *tsk )
+{
+	tsk_t **ptr = &Srp;
+
+	while (*ptr && *ptr != tsk)
+		ptr = &(*ptr)->srp;
+
+	if (*ptr)
+		*ptr = tsk->srp;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_PRIO_LEVELS == 0
+
+#define PRIO_LIMIT(prio) (prio)
+
 static
 void priv_tsk_insert( tsk_t *tsk )
 {
@@ -240,6 +824,124 @@ void priv_tsk_remove( tsk_t *tsk )
 
 /* -------------------------------------------------------------------------- */
 
+#else //OS_PRIO_LEVELS
+
+/* -------------------------------------------------------------------------- */
+
+#if     OS_PRIO_LEVELS > 1024
+#error  osconfig.h: Incorrect OS_PRIO_LEVELS value! Must be less or equal to 1024.
+#endif
+
+#if     OS_MAIN_PRIO >= OS_PRIO_LEVELS
+#error  osconfig.h: Incorrect OS_MAIN_PRIO value! Must be less then OS_PRIO_LEVELS.
+#endif
+
+#define PRIO_WORDS (((OS_PRIO_LEVELS)+31)/32)
+
+// priorities above the highest level are treated as the highest level
+#define PRIO_LIMIT(prio) ((prio) < (OS_PRIO_LEVELS) ? (prio) : (OS_PRIO_LEVELS)-1)
+
+static struct
+{
+	uint32_t grp;                   // bitmap of non-empty words of the 'map' table
+	uint32_t map[PRIO_WORDS];       // bitmap of non-empty priority levels
+	tsk_t  * head[OS_PRIO_LEVELS];  // first task of each priority level in the READY queue
+}	Ready = { .grp=1UL<<((OS_MAIN_PRIO)/32), .map[(OS_MAIN_PRIO)/32]=1UL<<((OS_MAIN_PRIO)%32), .head[OS_MAIN_PRIO]=&MAIN };
+
+/* -------------------------------------------------------------------------- */
+// return the first task in the READY queue with priority lower than 'prio'
+
+static
+tsk_t *priv_tsk_below( unsigned prio )
+{
+	unsigned i = prio / 32;
+	uint32_t m = Ready.map[i] & ((1UL << (prio % 32)) - 1);
+
+	if (m == 0)
+	{
+		uint32_t g = Ready.grp & ((1UL << i) - 1);
+		if (g == 0)
+			return &IDLE;
+		i = 31 - __CLZ(g);
+		m = Ready.map[i];
+	}
+
+	return Ready.head[i * 32 + 31 - __CLZ(m)];
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_link( tsk_t *tsk, tsk_t *nxt )
+{
+	unsigned prio = tsk->prio;
+
+	if (Ready.head[prio] == 0 || Ready.head[prio] == nxt)
+	{
+		Ready.head[prio] = tsk;
+		Ready.map[prio / 32] |= 1UL << (prio % 32);
+		Ready.grp |= 1UL << (prio / 32);
+	}
+
+	priv_rdy_insert(&tsk->obj, &nxt->obj);
+}
+
+/* -------------------------------------------------------------------------- */
+// insert task 'tsk' at the end of its priority level
+
+static
+void priv_tsk_insert( tsk_t *tsk )
+{
+	tsk->prio = PRIO_LIMIT(tsk->prio); // statically initialized or initialized with tsk_init
+#if OS_ROBIN && HW_TIMER_SIZE == 0
+	tsk->slice = 0;
+#endif
+	priv_tsk_link(tsk, priv_tsk_below(tsk->prio));
+}
+
+/* -------------------------------------------------------------------------- */
+// insert task 'tsk' at the beginning of its priority level
+
+static
+void priv_tsk_push( tsk_t *tsk )
+{
+	assert(tsk->prio < (OS_PRIO_LEVELS)); // limited by core_tsk_prio / core_cur_prio
+
+	priv_tsk_link(tsk, Ready.head[tsk->prio] ? Ready.head[tsk->prio] : priv_tsk_below(tsk->prio));
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_remove( tsk_t *tsk )
+{
+	unsigned prio = tsk->prio;
+	tsk_t  * nxt  = tsk->obj.next;
+
+	if (Ready.head[prio] == tsk)
+	{
+		if (nxt != &IDLE && nxt->prio == prio)
+		{
+			Ready.head[prio] = nxt;
+		}
+		else
+		{
+			Ready.head[prio] = 0;
+			Ready.map[prio / 32] &= ~(1UL << (prio % 32));
+			if (Ready.map[prio / 32] == 0)
+				Ready.grp &= ~(1UL << (prio / 32));
+		}
+	}
+
+	priv_rdy_remove(&tsk->obj);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_PRIO_LEVELS
+
+/* -------------------------------------------------------------------------- */
+
 void core_tsk_insert( tsk_t *tsk )
 {
 	tsk->id = ID_READY;
@@ -253,17 +955,62 @@ void core_tsk_insert( tsk_t *tsk )
 void core_tsk_remove( tsk_t *tsk )
 {
 	tsk->id = ID_STOPPED;
+#if OS_SRP_STACK
+	if (tsk->stack == SRP_STK)
+		priv_srp_remove(tsk);
+#endif
 	priv_tsk_remove(tsk);
 	if (tsk == System.cur)
+	{
+		assert(System.lock == 0); // the current task can not stop while the scheduler is locked
 		port_ctx_switchNow();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_stop( void )
+{
+	tsk_t *cur = System.cur;
+
+	assert(!cur->mtx.list);
+	assert(!cur->pcm);
+	assert(System.lock == 0); // the task can not stop while the scheduler is locked
+
+	if (cur->join != DETACHED)
+		core_tsk_wakeup(cur->join, E_SUCCESS);
+	else
+		core_sys_free(cur->obj.res);
+
+	core_tsk_remove(cur);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void core_ctx_init( tsk_t *tsk )
 {
-#ifdef DEBUG
+#if OS_SRP_STACK
+	if (tsk->stack == SRP_STK)
+	{
+#if OS_STACK_PAINT
+		if (SrpMark == 0) // no run-to-completion task has been started yet
+		{
+			memset(SRP_STK, 0xFF, sizeof(SRP_STK));
+			SrpMark = SRP_STK + SSIZE(OS_SRP_STACK);
+		}
+#endif
+		tsk->sp = 0; // the context is created on the shared stack when the task is dispatched
+		return;
+	}
+#endif
+#if OS_STACK_PAINT || defined(DEBUG)
 	memset(tsk->stack, 0xFF, (size_t)tsk->top - (size_t)tsk->stack);
+#endif
+#if OS_STACK_PAINT
+	tsk->mark = tsk->top;
+#endif
+#if OS_STACK_GUARD
+	assert((size_t)port_stk_limit(tsk->stack) < (size_t)((ctx_t *)tsk->top - 1));
 #endif
 	tsk->sp = (ctx_t *)tsk->top - 1;
 	port_ctx_init(tsk->sp, core_tsk_loop);
@@ -271,6 +1018,45 @@ void core_ctx_init( tsk_t *tsk )
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_STACK_PAINT
+
+unsigned core_stk_scan( tsk_t *tsk )
+{
+#if OS_STACK_GUARD
+	stk_t *ptr = tsk->stack ? port_stk_limit(tsk->stack) : 0; // the guard region cannot be read
+#else
+	stk_t *ptr = tsk->stack;
+#endif
+	stk_t **mark = &tsk->mark;
+	stk_t *top = tsk->top;
+	stk_t *end;
+
+#if OS_SRP_STACK
+	if (tsk->stack == SRP_STK) // run-to-completion tasks share the high-water mark of the shared stack
+	{
+		mark = &SrpMark;
+		top  = SRP_STK + SSIZE(OS_SRP_STACK);
+	}
+#endif
+	end = *mark;
+
+	if (end == 0)
+		return 0;
+
+	// the stack grows down, so the first word that lost its paint is the high-water mark;
+	// words above the recorded mark are known to be used and are not scanned again
+	while (ptr < end && *ptr == ~(stk_t)0)
+		ptr++;
+
+	*mark = ptr;
+
+	return (unsigned)((size_t)top - (size_t)ptr);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 void core_ctx_switch( void )
 {
 	tsk_t *cur = IDLE.obj.next;
@@ -281,14 +1067,37 @@ void core_ctx_switch( void )
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TASK_STATS
+
+void core_ctx_yield( void )
+{
+	tsk_t *cur = IDLE.obj.next;
+	tsk_t *nxt = cur->obj.next;
+	if (nxt->prio == cur->prio)
+	{
+		System.yld = cur;
+		port_ctx_switch();
+	}
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 void core_tsk_loop( void )
 {
 	for (;;)
 	{
+		port_fpu_reset(); // the task starts, restarts or is flipped: no floating-point context is alive
 		port_clr_lock();
 		System.cur->state();
+		assert(System.lock == 0); // the task can not restart while the scheduler is locked
 		port_set_lock();
-		core_ctx_switch();
+#if OS_SRP_STACK
+		if (System.cur->stack == SRP_STK)
+			core_tsk_stop(); // run-to-completion task releases its part of the shared stack
+#endif
+		core_ctx_yield();
 	}
 }
 
@@ -339,7 +1148,11 @@ static
 void priv_tsk_wait( tsk_t *tsk, void *obj )
 {
 	assert(!port_isr_inside());
+#if OS_SRP_STACK
+	assert(tsk->stack != SRP_STK || tsk->sp == 0); // run-to-completion task can not wait once it is started
+#endif
 
+	core_trc_event(TRC_WAIT, 0, tsk, obj);
 	core_tsk_append((tsk_t *)tsk, obj);
 	priv_tsk_remove((tsk_t *)tsk);
 	core_tmr_insert((tmr_t *)tsk, ID_DELAYED);
@@ -357,6 +1170,8 @@ unsigned core_tsk_waitUntil( void *obj, cnt_t time )
 	if (cur->delay > ((CNT_MAX)>>1))
 		return E_TIMEOUT;
 
+	assert(System.lock == 0); // the current task can not wait while the scheduler is locked
+
 	priv_tsk_wait(cur, obj);
 	port_ctx_switchLock();
 
@@ -375,6 +1190,8 @@ unsigned core_tsk_waitFor( void *obj, cnt_t delay )
 	if (cur->delay == IMMEDIATE)
 		return E_TIMEOUT;
 
+	assert(System.lock == 0); // the current task can not wait while the scheduler is locked
+
 	priv_tsk_wait(cur, obj);
 	port_ctx_switchLock();
 
@@ -385,6 +1202,8 @@ unsigned core_tsk_waitFor( void *obj, cnt_t delay )
 
 void core_tsk_suspend( tsk_t *tsk )
 {
+	assert(tsk != System.cur || System.lock == 0); // the current task can not suspend itself while the scheduler is locked
+
 	tsk->delay = INFINITE;
 
 	priv_tsk_wait(tsk, &WAIT);
@@ -398,6 +1217,7 @@ tsk_t *core_tsk_wakeup( tsk_t *tsk, unsigned event )
 {
 	if (tsk)
 	{
+		core_trc_event(TRC_WAKEUP, event, tsk, tsk->guard);
 		core_tsk_unlink((tsk_t *)tsk, event);
 		core_tmr_remove((tmr_t *)tsk);
 		core_tsk_insert((tsk_t *)tsk);
@@ -426,6 +1246,25 @@ void core_all_wakeup( void *obj, unsigned event )
 
 /* -------------------------------------------------------------------------- */
 
+static
+void priv_cur_prio( tsk_t *cur, unsigned prio )
+{
+#if OS_PRIO_LEVELS
+	priv_tsk_remove(cur);
+	cur->prio = prio;
+	priv_tsk_push(cur);
+	if (cur != IDLE.obj.next)
+		port_ctx_switch();
+#else
+	cur->prio = prio;
+	cur = cur->obj.next;
+	if (cur->prio > prio)
+		port_ctx_switch();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
 void core_tsk_prio( tsk_t *tsk, unsigned prio )
 {
 	mtx_t *mtx;
@@ -438,25 +1277,25 @@ void core_tsk_prio( tsk_t *tsk, unsigned prio )
 			if (prio < mtx->queue->prio)
 				prio = mtx->queue->prio;
 
+	prio = PRIO_LIMIT(prio);
+
 	if (tsk->prio != prio)
 	{
-		tsk->prio = prio;
-
 		if (tsk == System.cur)
 		{
-			tsk = tsk->obj.next;
-			if (tsk->prio > prio)
-				port_ctx_switch();
+			priv_cur_prio(tsk, prio);
 		}
 		else
 		if (tsk->id == ID_READY)
 		{
 			priv_tsk_remove(tsk);
+			tsk->prio = prio;
 			core_tsk_insert(tsk);
 		}
 		else
 		if (tsk->id == ID_DELAYED)
 		{
+			tsk->prio = prio;
 			core_tsk_transfer(tsk, tsk->guard);
 			if (tsk->mtx.tree)
 				core_tsk_prio(tsk->mtx.tree, prio);
@@ -479,15 +1318,35 @@ void core_cur_prio( unsigned prio )
 			if (prio < mtx->queue->prio)
 				prio = mtx->queue->prio;
 
+	prio = PRIO_LIMIT(prio);
+
 	if (tsk->prio != prio)
-	{
-		tsk->prio = prio;
-		tsk = tsk->obj.next;
-		if (tsk->prio > prio)
-			port_ctx_switch();
-	}
+		priv_cur_prio(tsk, prio);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TASK_STATS
+
+static
+void priv_tsk_stats( tsk_t *cur, tsk_t *nxt )
+{
+	uint32_t cyc = port_cyc_get();
+
+	if (cur->id == ID_READY && cur != System.yld)
+		cur->stat.preempt++;
+	else
+		cur->stat.yield++;
+
+	System.yld = 0;
+
+	cur->stat.time += cyc - cur->cyc;
+	nxt->stat.count++;
+	nxt->cyc = cyc;
 }
 
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 void *core_tsk_handler( void *sp )
@@ -501,13 +1360,25 @@ void *core_tsk_handler( void *sp )
 
 	cur = System.cur;
 	cur->sp = sp;
+#if __FPU_USED
+	assert(!cur->nofpu || !port_ctx_fpu(sp));
+#endif
 
 	nxt = IDLE.obj.next;
 
+	if (System.lock && cur->id == ID_READY) // the scheduler is locked, the switch is deferred until tsk_unlock
+		nxt = cur, System.pend = 1;
+	else
 #if OS_ROBIN && HW_TIMER_SIZE == 0
 	if (cur == nxt || (nxt->slice >= (OS_FREQUENCY)/(OS_ROBIN) && (nxt->slice = 0) == 0))
 #else
 	if (cur == nxt)
+#endif
+#if OS_PRIO_LEVELS
+	if (nxt != &IDLE) // idle task is not indexed in the READY queue
+#endif
+#if OS_SRP_STACK
+	if (nxt->stack != SRP_STK) // run-to-completion task is not moved behind the tasks of the same priority
 #endif
 	{
 		priv_tsk_remove(nxt);
@@ -515,6 +1386,23 @@ void *core_tsk_handler( void *sp )
 		nxt = IDLE.obj.next;
 	}
 
+#if OS_TASK_STATS
+	if (cur != nxt)
+		priv_tsk_stats(cur, nxt);
+#endif
+#if OS_TRACE
+	if (cur != nxt)
+		core_trc_event(TRC_SWITCH, 0, nxt, cur);
+#endif
+#if OS_STACK_GUARD
+	if (cur != nxt) // the small stack of the idle task has no room for the guard region
+		port_stk_guard(nxt == &IDLE ? 0 : nxt->stack);
+#endif
+#if OS_SRP_STACK
+	if (nxt->sp == 0) // run-to-completion task is dispatched for the first time since its start
+		priv_srp_start(nxt);
+#endif
+
 	System.cur = nxt;
 	sp = nxt->sp;
 
@@ -540,3 +1428,26 @@ void core_sys_tick( void )
 #endif
 
 /* -------------------------------------------------------------------------- */
+
+cnt_t core_sys_suspend( void )
+{
+#if HW_TIMER_SIZE == 0
+	port_tck_suspend();
+#endif
+	return core_tmr_delay();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_sys_resume( cnt_t ticks )
+{
+#if HW_TIMER_SIZE == 0
+	System.cnt += ticks;
+	port_tck_resume();
+#else
+	(void) ticks; // the hardware timer has not been stopped
+#endif
+	core_tmr_handler();
+}
+
+/* -------------------------------------------------------------------------- */
@@ -92,6 +92,10 @@ extern tsk_t IDLE;   // idle task, tasks' queue
 extern tmr_t WAIT;   // timers' queue
 extern sys_t System; // system data
 
+#if OS_SRP_STACK
+extern stk_t SRP_STK[]; // stack shared by run-to-completion tasks
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 #define core_stk_assert() \
@@ -109,9 +113,24 @@ void port_sys_init( void );
 // initiate task 'tsk' for context switch
 void core_ctx_init( tsk_t *tsk );
 
+// scan the painted stack of task 'tsk' for the stack high-water mark and return the peak stack usage (in bytes)
+// for run-to-completion tasks scan the shared stack
+// return 0 if the stack of the task is not painted (main and idle tasks)
+#if OS_STACK_PAINT
+unsigned core_stk_scan( tsk_t *tsk );
+#endif
+
 // save status of the current process and force yield system control to the next
 void core_ctx_switch( void );
 
+// as above, but the current process gives up the processor voluntarily
+#if OS_TASK_STATS
+void core_ctx_yield( void );
+#else
+__STATIC_INLINE
+void core_ctx_yield( void ) { core_ctx_switch(); }
+#endif
+
 // system infinite loop procedure for the current process
 __NO_RETURN
 void core_tsk_loop( void );
@@ -131,6 +150,66 @@ void *core_sys_alloc( size_t size );
 // system free procedure
 void core_sys_free( void *ptr );
 
+// statistics of the system heap
+typedef struct __hst hst_t;
+
+struct __hst
+{
+	size_t   free;    // free space in the system heap (in bytes)
+	size_t   largest; // size of the largest free memory segment (in bytes)
+	size_t   peak;    // high-water mark of the used space (in bytes)
+};
+
+// get statistics of the system heap
+void core_sys_stat( hst_t *hst );
+
+/* -------------------------------------------------------------------------- */
+
+// types of kernel trace records
+#define TRC_SWITCH   1U // context switch: 'obj' = next task,  'arg' = previous task
+#define TRC_WAIT     2U // task is blocked: 'obj' = task,      'arg' = supervising object
+#define TRC_WAKEUP   3U // task is woken:   'obj' = task,      'arg' = supervising object, 'info' = event
+#define TRC_TIMER    4U // timer expired:   'obj' = timer
+#define TRC_LOCK     5U // mutex locked:    'obj' = mutex,     'arg' = owner task
+#define TRC_UNLOCK   6U // mutex unlocked:  'obj' = mutex,     'arg' = owner task
+
+#if OS_TRACE
+
+// kernel trace record
+typedef struct __trc trc_t;
+
+struct __trc
+{
+	uint32_t time;    // cycle counter value
+	uint32_t type;    // type of the record (lower 8 bits) and additional information (upper 24 bits)
+	uint32_t obj;     // address of the object as its identifier
+	uint32_t arg;     // address of the second object as its identifier
+};
+
+// kernel trace ring buffer, a memory dump of this object is the input of the host decoder
+typedef struct __trb trb_t;
+
+struct __trb
+{
+	uint32_t magic;   // 'STRC'
+	uint32_t limit;   // size of the ring buffer (number of records)
+	uint32_t count;   // total number of recorded events, the next record is stored at index count % limit
+	uint32_t freq;    // frequency of the cycle counter (Hz)
+	trc_t    rec[OS_TRACE];
+};
+
+extern trb_t Trace;
+
+// record the kernel event in the trace ring buffer
+void core_trc_event( unsigned type, unsigned info, const void *obj, const void *arg );
+
+#else
+
+__STATIC_INLINE
+void core_trc_event( unsigned type, unsigned info, const void *obj, const void *arg ) { (void) type; (void) info; (void) obj; (void) arg; }
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 // insert timer 'tmr' into timers READY queue with id 'id' and start it
@@ -139,9 +218,23 @@ void core_tmr_insert( tmr_t *tmr, unsigned id );
 // remove timer 'tmr' from timers READY queue
 void core_tmr_remove( tmr_t *tmr );
 
+// return number of ticks until the nearest deadline in timers READY queue
+// return INFINITE if no timer is counting
+cnt_t core_tmr_delay( void );
+
 // timers queue handler procedure
 void core_tmr_handler( void );
 
+// return the timer (or delayed task) following timer 'tmr' in timers queue
+// core_tmr_next(&WAIT) returns the first timer in timers queue
+// return &WAIT if 'tmr' is the last one
+tmr_t *core_tmr_next( tmr_t *tmr );
+
+// start the timer service task if it is not running yet
+#if OS_TIMER_TASK
+void core_tmr_service( void );
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 // reset stack and restart the current task
@@ -155,6 +248,10 @@ void core_tsk_insert( tsk_t *tsk );
 // remove task 'tsk' from tasks READY queue
 void core_tsk_remove( tsk_t *tsk );
 
+// stop the current task: wake up the joining task or free the detached task's resource
+// and remove the current task from tasks READY queue
+void core_tsk_stop( void );
+
 // append task 'tsk' to the delayed queue of object 'obj'
 void core_tsk_append( tsk_t *tsk, void *obj );
 
@@ -255,6 +352,23 @@ void core_sys_tick( void )
 }
 #endif
 
+// stop the system timer in non-tick-less mode
+// return number of ticks until the nearest deadline in timers READY queue
+// must be called with the system locked, the caller keeps the scheduler locked until core_sys_resume
+cnt_t core_sys_suspend( void );
+
+// restart the system timer in non-tick-less mode and advance the system time by 'ticks'
+// call the timers handler procedure
+// must be called with the system locked
+void core_sys_resume( cnt_t ticks );
+
+// put the processor to sleep with the system timer interrupts suppressed for at most 'delay' ticks
+// must be called with all interrupts disabled
+// return the number of ticks that elapsed in the meantime, not including the pending system timer interrupt
+#if OS_TICK_SUPPRESS && HW_TIMER_SIZE == 0
+cnt_t port_sys_sleep( cnt_t delay );
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 #ifdef __cplusplus
@@ -0,0 +1,66 @@
+/******************************************************************************
+
+    @file    StateOS: ostrace.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   This file provides set of variables and functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "oskernel.h"
+
+/* -------------------------------------------------------------------------- */
+// KERNEL TRACE SERVICES
+/* -------------------------------------------------------------------------- */
+
+#if OS_TRACE
+
+/* -------------------------------------------------------------------------- */
+
+trb_t Trace = { 0x43525453UL, OS_TRACE, 0, CPU_FREQUENCY, { { 0, 0, 0, 0 } } };
+
+/* -------------------------------------------------------------------------- */
+
+void core_trc_event( unsigned type, unsigned info, const void *obj, const void *arg )
+{
+	trc_t *rec;
+
+	port_sys_lock();
+
+	rec = &Trace.rec[Trace.count++ % OS_TRACE];
+
+	rec->time = port_cyc_get();
+	rec->type = (type & 0xFFU) | ((uint32_t)info << 8);
+	rec->obj  = (uint32_t)(size_t)obj;
+	rec->arg  = (uint32_t)(size_t)arg;
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_TRACE
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,246 @@
+/******************************************************************************
+
+    @file    StateOS: osceilingmutex.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/osceilingmutex.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+void pcm_init( pcm_t *pcm, unsigned ceiling )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(pcm);
+
+	port_sys_lock();
+
+	memset(pcm, 0, sizeof(pcm_t));
+
+	pcm->ceiling = ceiling;
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+pcm_t *pcm_create( unsigned ceiling )
+/* -------------------------------------------------------------------------- */
+{
+	pcm_t *pcm;
+
+	assert(!port_isr_inside());
+
+	port_sys_lock();
+
+	pcm = core_sys_alloc(sizeof(pcm_t));
+	pcm_init(pcm, ceiling);
+	pcm->res = pcm;
+
+	port_sys_unlock();
+
+	return pcm;
+}
+
+/* -------------------------------------------------------------------------- */
+#ifndef NDEBUG
+static
+unsigned priv_pcm_basic( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	pcm_t *pcm = tsk->pcm;
+
+	if (pcm == 0)
+		return tsk->basic;
+
+	while (pcm->list)
+		pcm = pcm->list;
+
+	return pcm->prio; // basic priority of the task before it locked the first priority ceiling mutex
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pcm_link( pcm_t *pcm, tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	assert(pcm);
+
+	pcm->owner = tsk;
+
+	if (tsk)
+	{
+		core_trc_event(TRC_LOCK, 0, pcm, tsk);
+		pcm->prio = tsk->basic;
+		pcm->list = tsk->pcm;
+		tsk->pcm = pcm;
+
+		if (tsk->basic < pcm->ceiling)
+		{
+			tsk->basic = pcm->ceiling;
+			core_tsk_prio(tsk, tsk->basic);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pcm_unlink( pcm_t *pcm )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk;
+	pcm_t *lst;
+
+	assert(pcm);
+
+	if (pcm->owner)
+	{
+		tsk = pcm->owner;
+
+		core_trc_event(TRC_UNLOCK, 0, pcm, tsk);
+		if (tsk->pcm == pcm)
+		{
+			tsk->pcm = pcm->list;
+			tsk->basic = pcm->prio;
+		}
+		else // killed out of order, the mutex locked next takes over the level to restore
+		{
+			for (lst = tsk->pcm; lst->list != pcm; lst = lst->list);
+			lst->list = pcm->list;
+			lst->prio = pcm->prio;
+		}
+
+		pcm->list  = 0;
+		pcm->owner = 0;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+void pcm_kill( pcm_t *pcm )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk;
+
+	assert(!port_isr_inside());
+	assert(pcm);
+
+	port_sys_lock();
+
+	tsk = pcm->owner;
+	priv_pcm_unlink(pcm);
+	if (tsk)
+		core_tsk_prio(tsk, tsk->basic);
+
+	core_all_wakeup(pcm, E_STOPPED);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void pcm_delete( pcm_t *pcm )
+/* -------------------------------------------------------------------------- */
+{
+	port_sys_lock();
+
+	pcm_kill(pcm);
+	core_sys_free(pcm->res);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_pcm_wait( pcm_t *pcm, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(pcm);
+	assert(priv_pcm_basic(System.cur) <= pcm->ceiling); // the ceiling is violated
+
+	port_sys_lock();
+
+	if (pcm->owner == 0)
+	{
+		priv_pcm_link(pcm, System.cur);
+		event = E_SUCCESS;
+	}
+	else
+	if (pcm->owner != System.cur)
+	{
+		event = wait(pcm, time);
+	}
+	
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pcm_waitUntil( pcm_t *pcm, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_pcm_wait(pcm, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pcm_waitFor( pcm_t *pcm, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_pcm_wait(pcm, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pcm_give( pcm_t *pcm )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+	
+	assert(!port_isr_inside());
+	assert(pcm);
+
+	port_sys_lock();
+
+	if (pcm->owner == System.cur)
+	{
+		assert(System.cur->pcm == pcm); // unlock in the reverse order of locking
+
+		priv_pcm_unlink(pcm);
+		priv_pcm_link(pcm, core_one_wakeup(pcm, E_SUCCESS));
+		core_cur_prio(System.cur->basic);
+		event = E_SUCCESS;
+	}
+
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
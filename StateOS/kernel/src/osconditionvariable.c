@@ -30,6 +30,7 @@
  ******************************************************************************/
 
 #include "inc/osconditionvariable.h"
+#include "inc/ostask.h"
 
 /* -------------------------------------------------------------------------- */
 void cnd_init( cnd_t *cnd )
@@ -103,10 +104,16 @@ unsigned priv_cnd_wait( cnd_t *cnd, mtx_t *mtx, cnt_t time, unsigned(*wait)(void
 
 	port_sys_lock();
 
+	System.cur->tmp.cnd.mtx = mtx;
+	System.cur->tmp.cnd.morph = false;
+
 	if ((event = mtx_give(mtx))   == E_SUCCESS)
 	if ((event = wait(cnd, time)) == E_SUCCESS)
+	if (!System.cur->tmp.cnd.morph) // the task was not moved to the mutex queue by cnd_give
 	     event = mtx_wait(mtx);
 
+	System.cur->mtx.tree = 0;
+
 	port_sys_unlock();
 
 	return event;
@@ -126,6 +133,39 @@ unsigned cnd_waitFor( cnd_t *cnd, mtx_t *mtx, cnt_t delay )
 	return priv_cnd_wait(cnd, mtx, delay, core_tsk_waitFor);
 }
 
+/* -------------------------------------------------------------------------- */
+static
+tsk_t *priv_cnd_wakeup( cnd_t *cnd )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk = cnd->queue;
+	mtx_t *mtx;
+
+	if (tsk)
+	{
+		mtx = tsk->tmp.cnd.mtx;
+
+		if (mtx->owner == 0 || mtx->owner == tsk) // the task still holds the recursive mutex, mtx_wait restores its count
+		{
+			core_tsk_wakeup(tsk, E_SUCCESS);
+		}
+		else // wait morphing: the task could not proceed anyway, so it waits for the mutex instead of being scheduled
+		{
+			tsk->tmp.cnd.morph = true;
+			core_tsk_transfer(tsk, mtx);
+			tsk->mtx.tree = mtx->owner;
+			if (mtx->owner->prio < tsk->prio)
+				core_tsk_prio(mtx->owner, tsk->prio);
+
+			core_tmr_remove((tmr_t *)tsk); // the mutex is waited for without a timeout, like in mtx_wait
+			tsk->delay = INFINITE;
+			core_tmr_insert((tmr_t *)tsk, ID_DELAYED);
+		}
+	}
+
+	return tsk;
+}
+
 /* -------------------------------------------------------------------------- */
 void cnd_give( cnd_t *cnd, bool all )
 /* -------------------------------------------------------------------------- */
@@ -134,8 +174,8 @@ void cnd_give( cnd_t *cnd, bool all )
 
 	port_sys_lock();
 
-	if (all) core_all_wakeup(cnd, E_SUCCESS);
-	else     core_one_wakeup(cnd, E_SUCCESS);
+	if (all) while (priv_cnd_wakeup(cnd));
+	else     priv_cnd_wakeup(cnd);
 
 	port_sys_unlock();
 }
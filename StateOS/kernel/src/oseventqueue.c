@@ -130,6 +130,50 @@ void priv_evq_put( evq_t *evq, unsigned event )
 	evq->count++;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_evq_getMany( evq_t *evq, unsigned *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned i = evq->head;
+	unsigned n = evq->limit - i;
+
+	evq->count -= count;
+	if (count < n)
+	{
+		memcpy(data, &evq->data[i], count * sizeof(unsigned));
+		evq->head = i + count;
+	}
+	else
+	{
+		memcpy(data, &evq->data[i], n * sizeof(unsigned));
+		memcpy(data + n, evq->data, (count - n) * sizeof(unsigned));
+		evq->head = count - n;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_evq_putMany( evq_t *evq, const unsigned *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned i = evq->tail;
+	unsigned n = evq->limit - i;
+
+	evq->count += count;
+	if (count < n)
+	{
+		memcpy(&evq->data[i], data, count * sizeof(unsigned));
+		evq->tail = i + count;
+	}
+	else
+	{
+		memcpy(&evq->data[i], data, n * sizeof(unsigned));
+		memcpy(evq->data, data + n, (count - n) * sizeof(unsigned));
+		evq->tail = count - n;
+	}
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned evq_take( evq_t *evq )
 /* -------------------------------------------------------------------------- */
@@ -240,6 +284,7 @@ unsigned priv_evq_send( evq_t *evq, unsigned data, cnt_t time, unsigned(*wait)(v
 	}
 	else
 	{
+		System.cur->tmp.evq.event = data;
 		event = wait(evq, time);
 	}
 
@@ -262,6 +307,66 @@ unsigned evq_sendFor( evq_t *evq, unsigned data, cnt_t delay )
 	return priv_evq_send(evq, data, delay, core_tsk_waitFor);
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned evq_takeMany( evq_t *evq, unsigned *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * tsk;
+	unsigned cnt = 0;
+	unsigned n;
+
+	assert(evq);
+	assert(data);
+
+	port_sys_lock();
+
+	while (cnt < count && evq->count > 0)
+	{
+		n = count - cnt;
+		if (n > evq->count) n = evq->count;
+		priv_evq_getMany(evq, data + cnt, n);
+		cnt += n;
+
+		while (evq->queue != 0 && evq->count < evq->limit) // tasks waiting to send
+		{
+			tsk = core_one_wakeup(evq, E_SUCCESS);
+			priv_evq_put(evq, tsk->tmp.evq.event);
+		}
+	}
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned evq_giveMany( evq_t *evq, const unsigned *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt = 0;
+	unsigned n;
+
+	assert(evq);
+	assert(data);
+
+	port_sys_lock();
+
+	if (evq->count == 0)
+	{
+		while (cnt < count && evq->queue != 0) // tasks waiting to receive
+			core_one_wakeup(evq, data[cnt++]);
+	}
+
+	n = evq->limit - evq->count;
+	if (n > count - cnt) n = count - cnt;
+	priv_evq_putMany(evq, data + cnt, n);
+	cnt += n;
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned evq_push( evq_t *evq, unsigned data )
 /* -------------------------------------------------------------------------- */
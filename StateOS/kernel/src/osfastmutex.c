@@ -105,6 +105,7 @@ unsigned priv_mut_wait( mut_t *mut, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 	if (mut->owner == 0)
 	{
 		mut->owner = System.cur;
+		core_trc_event(TRC_LOCK, 0, mut, mut->owner);
 		event = E_SUCCESS;
 	}
 	else
@@ -145,7 +146,10 @@ unsigned mut_give( mut_t *mut )
 
 	if (mut->owner == System.cur)
 	{
+		core_trc_event(TRC_UNLOCK, 0, mut, mut->owner);
 		mut->owner = core_one_wakeup(mut, E_SUCCESS);
+		if (mut->owner)
+			core_trc_event(TRC_LOCK, 0, mut, mut->owner);
 		event = E_SUCCESS;
 	}
 
@@ -69,12 +69,20 @@ flg_t *flg_create( void )
 void flg_kill( flg_t *flg )
 /* -------------------------------------------------------------------------- */
 {
+#if OS_FLAG_INDEX
+	unsigned i;
+#endif
+
 	assert(!port_isr_inside());
 	assert(flg);
 
 	port_sys_lock();
 
 	core_all_wakeup(flg, E_STOPPED);
+#if OS_FLAG_INDEX
+	for (i = 0; i < 32; i++)
+		core_all_wakeup(&flg->index[i], E_STOPPED);
+#endif
 
 	port_sys_unlock();
 }
@@ -137,6 +145,11 @@ unsigned priv_flg_wait( flg_t *flg, unsigned flags, unsigned mode, cnt_t time, u
 	{
 		System.cur->tmp.flg.mode  = mode;
 		System.cur->tmp.flg.flags = value;
+#if OS_FLAG_INDEX
+		if ((value & (value - 1)) == 0) // waiting for a single flag
+			event = wait(&flg->index[31 - __CLZ(value)], time);
+		else
+#endif
 		event = wait(flg, time);
 	}
 
@@ -164,6 +177,11 @@ unsigned flg_give( flg_t *flg, unsigned flags )
 /* -------------------------------------------------------------------------- */
 {
 	tsk_t *tsk;
+#if OS_FLAG_INDEX
+	unsigned mask;
+	unsigned flag;
+	tsk_t  **queue;
+#endif
 	
 	assert(flg);
 
@@ -171,6 +189,21 @@ unsigned flg_give( flg_t *flg, unsigned flags )
 
 	flags = flg->flags |= flags;
 
+#if OS_FLAG_INDEX
+	for (mask = flags; mask; mask &= ~flag)
+	{
+		flag  = mask & -mask;
+		queue = &flg->index[31 - __CLZ(flag)];
+		while ((tsk = *queue) != 0) // every task in the queue is waiting for this flag only
+		{
+			if ((tsk->tmp.flg.mode & flgProtect) == 0)
+				flg->flags &= ~flag;
+			tsk->tmp.flg.flags = 0;
+			core_one_wakeup(queue, E_SUCCESS);
+		}
+	}
+#endif
+
 	for (tsk = flg->queue; tsk; tsk = tsk->obj.queue)
 	{
 		if (tsk->tmp.flg.flags & flags)
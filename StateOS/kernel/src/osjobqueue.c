@@ -33,7 +33,7 @@
 #include "inc/ostask.h"
 
 /* -------------------------------------------------------------------------- */
-void job_init( job_t *job, unsigned limit, fun_t **data )
+void job_init( job_t *job, unsigned limit, jbd_t *data )
 /* -------------------------------------------------------------------------- */
 {
 	assert(!port_isr_inside());
@@ -62,7 +62,7 @@ job_t *job_create( unsigned limit )
 
 	port_sys_lock();
 
-	job = core_sys_alloc(ABOVE(sizeof(job_t)) + limit * sizeof(fun_t *));
+	job = core_sys_alloc(ABOVE(sizeof(job_t)) + limit * sizeof(jbd_t));
 	job_init(job, limit, (void *)((size_t)job + ABOVE(sizeof(job_t))));
 	job->res = job;
 
@@ -103,37 +103,46 @@ void job_delete( job_t *job )
 
 /* -------------------------------------------------------------------------- */
 static
-fun_t *priv_job_get( job_t *job )
+void priv_job_get( job_t *job, jbd_t *jbd )
 /* -------------------------------------------------------------------------- */
 {
-	fun_t  * fun;
 	unsigned i = job->head;
 
-	fun = job->data[i++];
+	*jbd = job->data[i++];
+
 	job->head = (i < job->limit) ? i : 0;
 	job->count--;
-
-	return fun;
 }
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_job_put( job_t *job, fun_t *fun )
+void priv_job_put( job_t *job, const jbd_t *jbd )
 /* -------------------------------------------------------------------------- */
 {
 	unsigned i = job->tail;
 
-	job->data[i++] = fun;
+	job->data[i++] = *jbd;
 
 	job->tail = (i < job->limit) ? i : 0;
 	job->count++;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_job_run( const jbd_t *jbd )
+/* -------------------------------------------------------------------------- */
+{
+	if (jbd->act)
+		jbd->act(jbd->par.arg);
+	else
+		jbd->par.fun();
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned job_take( job_t *job )
 /* -------------------------------------------------------------------------- */
 {
-	fun_t  * fun;
+	jbd_t    jbd;
 	tsk_t  * tsk;
 	unsigned event = E_TIMEOUT;
 
@@ -143,15 +152,17 @@ unsigned job_take( job_t *job )
 
 	if (job->count > 0)
 	{
-		fun = priv_job_get(job);
+		priv_job_get(job, &jbd);
 		tsk = core_one_wakeup(job, E_SUCCESS);
-		if (tsk) priv_job_put(job, tsk->tmp.job.fun);
-		fun();
+		if (tsk) priv_job_put(job, &tsk->tmp.job);
 		event = E_SUCCESS;
 	}
-	
+
 	port_sys_unlock();
 
+	if (event == E_SUCCESS)
+		priv_job_run(&jbd);
+
 	return event;
 }
 
@@ -160,6 +171,7 @@ static
 unsigned priv_job_wait( job_t *job, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 /* -------------------------------------------------------------------------- */
 {
+	jbd_t    jbd;
 	tsk_t  * tsk;
 	unsigned event;
 
@@ -170,21 +182,22 @@ unsigned priv_job_wait( job_t *job, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 
 	if (job->count > 0)
 	{
-		System.cur->tmp.job.fun = priv_job_get(job);
+		priv_job_get(job, &jbd);
 		tsk = core_one_wakeup(job, E_SUCCESS);
-		if (tsk) priv_job_put(job, tsk->tmp.job.fun);
+		if (tsk) priv_job_put(job, &tsk->tmp.job);
 		event = E_SUCCESS;
 	}
 	else
 	{
 		event = wait(job, time);
+		jbd = System.cur->tmp.job;
 	}
 
-	if (event == E_SUCCESS)
-		System.cur->tmp.job.fun();
-
 	port_sys_unlock();
 
+	if (event == E_SUCCESS)
+		priv_job_run(&jbd);
+
 	return event;
 }
 
@@ -203,22 +216,22 @@ unsigned job_waitFor( job_t *job, cnt_t delay )
 }
 
 /* -------------------------------------------------------------------------- */
-unsigned job_give( job_t *job, fun_t *fun )
+static
+unsigned priv_job_give( job_t *job, const jbd_t *jbd )
 /* -------------------------------------------------------------------------- */
 {
 	tsk_t  * tsk;
 	unsigned event = E_TIMEOUT;
 
 	assert(job);
-	assert(fun);
 
 	port_sys_lock();
 
 	if (job->count < job->limit)
 	{
-		priv_job_put(job, fun);
+		priv_job_put(job, jbd);
 		tsk = core_one_wakeup(job, E_SUCCESS);
-		if (tsk) tsk->tmp.job.fun = priv_job_get(job);
+		if (tsk) priv_job_get(job, &tsk->tmp.job);
 		event = E_SUCCESS;
 	}
 
@@ -227,9 +240,31 @@ unsigned job_give( job_t *job, fun_t *fun )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned job_give( job_t *job, fun_t *fun )
+/* -------------------------------------------------------------------------- */
+{
+	jbd_t jbd = { .act = 0, .par.fun = fun };
+
+	assert(fun);
+
+	return priv_job_give(job, &jbd);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned job_giveArg( job_t *job, act_t *act, void *arg )
+/* -------------------------------------------------------------------------- */
+{
+	jbd_t jbd = { .act = act, .par.arg = arg };
+
+	assert(act);
+
+	return priv_job_give(job, &jbd);
+}
+
 /* -------------------------------------------------------------------------- */
 static
-unsigned priv_job_send( job_t *job, fun_t *fun, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+unsigned priv_job_send( job_t *job, const jbd_t *jbd, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 /* -------------------------------------------------------------------------- */
 {
 	tsk_t  * tsk;
@@ -237,20 +272,19 @@ unsigned priv_job_send( job_t *job, fun_t *fun, cnt_t time, unsigned(*wait)(void
 
 	assert(!port_isr_inside());
 	assert(job);
-	assert(fun);
 
 	port_sys_lock();
 
 	if (job->count < job->limit)
 	{
-		priv_job_put(job, fun);
+		priv_job_put(job, jbd);
 		tsk = core_one_wakeup(job, E_SUCCESS);
-		if (tsk) tsk->tmp.job.fun = priv_job_get(job);
+		if (tsk) priv_job_get(job, &tsk->tmp.job);
 		event = E_SUCCESS;
 	}
 	else
 	{
-		System.cur->tmp.job.fun = fun;
+		System.cur->tmp.job = *jbd;
 		event = wait(job, time);
 	}
 
@@ -263,38 +297,68 @@ unsigned priv_job_send( job_t *job, fun_t *fun, cnt_t time, unsigned(*wait)(void
 unsigned job_sendUntil( job_t *job, fun_t *fun, cnt_t time )
 /* -------------------------------------------------------------------------- */
 {
-	return priv_job_send(job, fun, time, core_tsk_waitUntil);
+	jbd_t jbd = { .act = 0, .par.fun = fun };
+
+	assert(fun);
+
+	return priv_job_send(job, &jbd, time, core_tsk_waitUntil);
 }
 
 /* -------------------------------------------------------------------------- */
 unsigned job_sendFor( job_t *job, fun_t *fun, cnt_t delay )
 /* -------------------------------------------------------------------------- */
 {
-	return priv_job_send(job, fun, delay, core_tsk_waitFor);
+	jbd_t jbd = { .act = 0, .par.fun = fun };
+
+	assert(fun);
+
+	return priv_job_send(job, &jbd, delay, core_tsk_waitFor);
 }
 
 /* -------------------------------------------------------------------------- */
-unsigned job_push( job_t *job, fun_t *fun )
+unsigned job_sendArgUntil( job_t *job, act_t *act, void *arg, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	jbd_t jbd = { .act = act, .par.arg = arg };
+
+	assert(act);
+
+	return priv_job_send(job, &jbd, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned job_sendArgFor( job_t *job, act_t *act, void *arg, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	jbd_t jbd = { .act = act, .par.arg = arg };
+
+	assert(act);
+
+	return priv_job_send(job, &jbd, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_job_push( job_t *job, const jbd_t *jbd )
 /* -------------------------------------------------------------------------- */
 {
 	tsk_t  * tsk;
 	unsigned event = E_TIMEOUT;
 
 	assert(job);
-	assert(fun);
 
 	port_sys_lock();
 
 	if (job->count == 0 || job->queue == 0)
 	{
-		priv_job_put(job, fun);
+		priv_job_put(job, jbd);
 		if (job->count > job->limit)
 		{
 			job->count = job->limit;
 			job->head = job->tail;
 		}
 		tsk = core_one_wakeup(job, E_SUCCESS);
-		if (tsk) tsk->tmp.job.fun = priv_job_get(job);
+		if (tsk) priv_job_get(job, &tsk->tmp.job);
 		event = E_SUCCESS;
 	}
 
@@ -304,3 +368,25 @@ unsigned job_push( job_t *job, fun_t *fun )
 }
 
 /* -------------------------------------------------------------------------- */
+unsigned job_push( job_t *job, fun_t *fun )
+/* -------------------------------------------------------------------------- */
+{
+	jbd_t jbd = { .act = 0, .par.fun = fun };
+
+	assert(fun);
+
+	return priv_job_push(job, &jbd);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned job_pushArg( job_t *job, act_t *act, void *arg )
+/* -------------------------------------------------------------------------- */
+{
+	jbd_t jbd = { .act = act, .par.arg = arg };
+
+	assert(act);
+
+	return priv_job_push(job, &jbd);
+}
+
+/* -------------------------------------------------------------------------- */
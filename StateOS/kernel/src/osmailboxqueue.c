@@ -136,12 +136,12 @@ void priv_box_get( box_t *box, char *data )
 /* -------------------------------------------------------------------------- */
 {
 	unsigned i = box->head;
-	unsigned j = 0;
 
-	do data[j++] = box->data[i++]; while (j < box->size);
+	memcpy(data, &box->data[i], box->size);
 
+	i += box->size;
 	box->head = (i < box->limit) ? i : 0;
-	box->count -= j;
+	box->count -= box->size;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -150,12 +150,56 @@ void priv_box_put( box_t *box, const char *data )
 /* -------------------------------------------------------------------------- */
 {
 	unsigned i = box->tail;
-	unsigned j = 0;
 
-	do box->data[i++] = data[j++]; while (j < box->size);
+	memcpy(&box->data[i], data, box->size);
 
+	i += box->size;
 	box->tail = (i < box->limit) ? i : 0;
-	box->count += j;
+	box->count += box->size;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_box_getMany( box_t *box, char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned i = box->head;
+	unsigned n = box->limit - i;
+
+	box->count -= size;
+	if (size < n)
+	{
+		memcpy(data, &box->data[i], size);
+		box->head = i + size;
+	}
+	else
+	{
+		memcpy(data, &box->data[i], n);
+		memcpy(data + n, box->data, size - n);
+		box->head = size - n;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_box_putMany( box_t *box, const char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned i = box->tail;
+	unsigned n = box->limit - i;
+
+	box->count += size;
+	if (size < n)
+	{
+		memcpy(&box->data[i], data, size);
+		box->tail = i + size;
+	}
+	else
+	{
+		memcpy(&box->data[i], data, n);
+		memcpy(box->data, data + n, size - n);
+		box->tail = size - n;
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -312,6 +356,72 @@ unsigned box_sendFor( box_t *box, const void *data, cnt_t delay )
 	return priv_box_send(box, data, delay, core_tsk_waitFor);
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned box_takeMany( box_t *box, void *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * tsk;
+	unsigned size = count * box->size;
+	unsigned n;
+
+	assert(box);
+	assert(data);
+
+	port_sys_lock();
+
+	while (size > 0 && box->count > 0)
+	{
+		n = (size < box->count) ? size : box->count;
+		priv_box_getMany(box, data, n);
+		data = (char *)data + n;
+		size -= n;
+
+		while (box->queue != 0 && box->count < box->limit) // tasks waiting to send
+		{
+			tsk = core_one_wakeup(box, E_SUCCESS);
+			priv_box_put(box, tsk->tmp.box.data.out);
+		}
+	}
+
+	port_sys_unlock();
+
+	return count - size / box->size;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned box_giveMany( box_t *box, const void *data, unsigned count )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * tsk;
+	unsigned size = count * box->size;
+	unsigned n;
+
+	assert(box);
+	assert(data);
+
+	port_sys_lock();
+
+	if (box->count == 0)
+	{
+		while (size > 0 && box->queue != 0) // tasks waiting to receive
+		{
+			tsk = core_one_wakeup(box, E_SUCCESS);
+			memcpy(tsk->tmp.box.data.in, data, box->size);
+			data = (const char *)data + box->size;
+			size -= box->size;
+		}
+	}
+
+	n = box->limit - box->count;
+	if (n > size) n = size;
+	priv_box_putMany(box, data, n);
+	size -= n;
+
+	port_sys_unlock();
+
+	return count - size / box->size;
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned box_push( box_t *box, const void *data )
 /* -------------------------------------------------------------------------- */
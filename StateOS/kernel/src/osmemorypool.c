@@ -32,26 +32,93 @@
 #include "inc/osmemorypool.h"
 #include "inc/ostask.h"
 
+/* -------------------------------------------------------------------------- */
+// the head of the list of free memory objects holds the index (counted from 1) of the first free object
+// in the lower half-word and the ABA tag, incremented at every update, in the upper half-word
+
+#define MEM_IDX  0x0000FFFFUL
+#define MEM_TAG  0x00010000UL
+
+/* -------------------------------------------------------------------------- */
+static
+uint32_t *priv_mem_object( mem_t *mem, uint32_t idx )
+/* -------------------------------------------------------------------------- */
+{
+	return (uint32_t *)((que_t *)mem->data + MHEAD + (idx - 1) * (MHEAD + mem->size));
+}
+
+/* -------------------------------------------------------------------------- */
+static
+uint32_t priv_mem_index( mem_t *mem, const void *data )
+/* -------------------------------------------------------------------------- */
+{
+	size_t offset = (size_t)data - (size_t)((que_t *)mem->data + MHEAD); // wraps around below the buffer
+	size_t size   = (MHEAD + mem->size) * sizeof(que_t);
+
+	if (offset >= mem->limit * size || offset % size != 0)
+		return 0;
+
+	return (uint32_t)(offset / size + 1);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void *priv_mem_pop( mem_t *mem )
+/* -------------------------------------------------------------------------- */
+{
+	uint32_t head;
+	uint32_t next;
+	uint32_t*obj;
+
+	do
+	{
+		head = mem->head;
+		if ((head & MEM_IDX) == 0)
+			return 0;
+		obj  = priv_mem_object(mem, head & MEM_IDX);
+		next = *obj; // it can be out of date, then the tag of the head has been changed
+	}
+	while (!port_cas_word(&mem->head, head, ((head + MEM_TAG) & ~MEM_IDX) | next));
+
+	return obj;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_mem_push( mem_t *mem, const void *data, uint32_t idx )
+/* -------------------------------------------------------------------------- */
+{
+	uint32_t head;
+	uint32_t*obj = (uint32_t *)data;
+
+	do
+	{
+		head = mem->head;
+		*obj = head & MEM_IDX;
+	}
+	while (!port_cas_word(&mem->head, head, ((head + MEM_TAG) & ~MEM_IDX) | idx));
+}
+
 /* -------------------------------------------------------------------------- */
 void mem_bind( mem_t *mem )
 /* -------------------------------------------------------------------------- */
 {
-	que_t  * ptr;
-	unsigned cnt;
+	uint32_t idx;
 
 	assert(!port_isr_inside());
 	assert(mem);
 	assert(mem->limit);
+	assert(mem->limit <= MEM_IDX);
 	assert(mem->size);
 	assert(mem->data);
 
 	port_sys_lock();
 	
-	ptr = mem->data;
-	cnt = mem->limit;
+	for (idx = 1; idx < mem->limit; idx++)
+		*priv_mem_object(mem, idx) = idx + 1;
+	*priv_mem_object(mem, idx) = 0;
 
-	mem->head.next = 0;
-	while (cnt--) { mem_give(mem, ++ptr); ptr += mem->size; }
+	mem->head = 1;
 
 	port_sys_unlock();
 }
@@ -93,7 +160,7 @@ mem_t *mem_create( unsigned limit, unsigned size )
 
 	port_sys_lock();
 
-	mem = core_sys_alloc(ABOVE(sizeof(mem_t)) + limit * (1 + size) * sizeof(que_t));
+	mem = core_sys_alloc(ABOVE(sizeof(mem_t)) + limit * (MHEAD + size) * sizeof(que_t));
 	mem_init(mem, limit, size, (void *)((size_t)mem + ABOVE(sizeof(mem_t))));
 	mem->res = mem;
 
@@ -129,3 +196,143 @@ void mem_delete( mem_t *mem )
 }
 
 /* -------------------------------------------------------------------------- */
+unsigned mem_take( mem_t *mem, void **data )
+/* -------------------------------------------------------------------------- */
+{
+	void *obj;
+
+	assert(mem);
+	assert(data);
+
+	obj = priv_mem_pop(mem); // lock-free path
+
+	if (obj == 0)
+		return E_TIMEOUT;
+
+	*data = obj;
+
+	return E_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_mem_wait( mem_t *mem, void **data, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_SUCCESS;
+	void   * obj;
+
+	assert(!port_isr_inside());
+	assert(mem);
+	assert(data);
+
+	port_sys_lock();
+
+	obj = priv_mem_pop(mem);
+
+	if (obj)
+	{
+		*data = obj;
+	}
+	else
+	{
+		System.cur->tmp.lst.data.in = data;
+		event = wait(mem, time);
+	}
+
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned mem_waitUntil( mem_t *mem, void **data, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_mem_wait(mem, data, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned mem_waitFor( mem_t *mem, void **data, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_mem_wait(mem, data, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+void mem_give( mem_t *mem, const void *data )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * tsk;
+	uint32_t idx;
+
+	assert(mem);
+	assert(data);
+
+	idx = priv_mem_index(mem, data);
+
+	assert(idx);
+
+	if (idx == 0)
+		return; // memory object from the wrong memory pool would corrupt the list of free objects
+
+	if (mem->queue == 0)
+	{
+		priv_mem_push(mem, data, idx); // lock-free path
+
+		if (mem->queue == 0)
+			return;
+
+		data = 0; // a task started waiting in the meantime
+	}
+
+	port_sys_lock();
+
+	if (data == 0)
+		data = priv_mem_pop(mem);
+
+	while (data)
+	{
+		tsk = core_one_wakeup(mem, E_SUCCESS);
+
+		if (tsk == 0)
+		{
+			priv_mem_push(mem, data, priv_mem_index(mem, data));
+			break;
+		}
+
+		*tsk->tmp.lst.data.out = data;
+		data = priv_mem_pop(mem);
+	}
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+bool mem_owns( mem_t *mem, const void *data )
+/* -------------------------------------------------------------------------- */
+{
+	assert(mem);
+
+	return priv_mem_index(mem, data) != 0;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned mem_space( mem_t *mem )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt = 0;
+	uint32_t idx;
+
+	assert(mem);
+
+	port_sys_lock();
+
+	for (idx = mem->head & MEM_IDX; idx; idx = *priv_mem_object(mem, idx)) cnt++;
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
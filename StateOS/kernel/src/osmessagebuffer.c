@@ -135,16 +135,21 @@ static
 void priv_msg_get( msg_t *msg, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i;
+	unsigned i = msg->head;
+	unsigned n = msg->limit - i;
 
-	msg->count -= size;;
-	i = msg->head;
-	while (size--)
+	msg->count -= size;
+	if (size < n)
 	{
-		*data++ = msg->data[i++];
-		if (i >= msg->limit) i = 0;
+		memcpy(data, &msg->data[i], size);
+		msg->head = i + size;
+	}
+	else
+	{
+		memcpy(data, &msg->data[i], n);
+		memcpy(data + n, msg->data, size - n);
+		msg->head = size - n;
 	}
-	msg->head = i;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -152,16 +157,21 @@ static
 void priv_msg_put( msg_t *msg, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i;
+	unsigned i = msg->tail;
+	unsigned n = msg->limit - i;
 
 	msg->count += size;
-	i = msg->tail;
-	while (size--)
+	if (size < n)
+	{
+		memcpy(&msg->data[i], data, size);
+		msg->tail = i + size;
+	}
+	else
 	{
-		msg->data[i++] = *data++;
-		if (i >= msg->limit) i = 0;
+		memcpy(&msg->data[i], data, n);
+		memcpy(msg->data, data + n, size - n);
+		msg->tail = size - n;
 	}
-	msg->tail = i;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -76,6 +76,7 @@ void priv_mtx_link( mtx_t *mtx, tsk_t *tsk )
 
 	if (tsk)
 	{
+		core_trc_event(TRC_LOCK, 0, mtx, tsk);
 		mtx->list = tsk->mtx.list;
 		tsk->mtx.list = mtx;
 	}
@@ -95,6 +96,7 @@ void priv_mtx_unlink( mtx_t *mtx )
 	{
 		tsk = mtx->owner;
 
+		core_trc_event(TRC_UNLOCK, 0, mtx, tsk);
 		if (tsk->mtx.list == mtx)
 			tsk->mtx.list = mtx->list;
 
@@ -148,6 +150,9 @@ unsigned priv_mtx_wait( mtx_t *mtx, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 
 	assert(!port_isr_inside());
 	assert(mtx);
+#if OS_SRP_STACK
+	assert(System.cur->stack != SRP_STK); // run-to-completion task can not wait for or inherit the priority through the mutex
+#endif
 
 	port_sys_lock();
 
@@ -0,0 +1,412 @@
+/******************************************************************************
+
+    @file    StateOS: ospriorityqueue.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/ospriorityqueue.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+static
+pbh_t *priv_pbx_slot( pbx_t *pbx, unsigned num )
+/* -------------------------------------------------------------------------- */
+{
+	return (pbh_t *)((unsigned *)pbx->data + num * (PHEAD + PSIZE(pbx->size)));
+}
+
+/* -------------------------------------------------------------------------- */
+static
+bool priv_pbx_before( pbh_t *slot, pbh_t *next )
+/* -------------------------------------------------------------------------- */
+{
+	if (slot->prio != next->prio)
+		return slot->prio > next->prio;
+
+	return (int)(slot->seq - next->seq) < 0; // mails with the same priority in the FIFO order
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pbx_bind( pbx_t *pbx )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned num;
+
+	for (num = 0; num < pbx->limit; num++)
+		priv_pbx_slot(pbx, num)->heap = num;
+}
+
+/* -------------------------------------------------------------------------- */
+void pbx_bind( pbx_t *pbx )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(pbx);
+	assert(pbx->limit);
+	assert(pbx->size);
+	assert(pbx->data);
+
+	port_sys_lock();
+
+	priv_pbx_bind(pbx);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void pbx_init( pbx_t *pbx, unsigned limit, void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(pbx);
+	assert(limit);
+	assert(data);
+	assert(size);
+
+	port_sys_lock();
+
+	memset(pbx, 0, sizeof(pbx_t));
+	
+	pbx->limit = limit;
+	pbx->size  = size;
+	pbx->data  = data;
+
+	pbx_bind(pbx);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+pbx_t *pbx_create( unsigned limit, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	pbx_t *pbx;
+
+	assert(!port_isr_inside());
+	assert(limit);
+	assert(size);
+
+	port_sys_lock();
+
+	pbx = core_sys_alloc(ABOVE(sizeof(pbx_t)) + limit * (PHEAD + PSIZE(size)) * sizeof(unsigned));
+	pbx_init(pbx, limit, (void *)((size_t)pbx + ABOVE(sizeof(pbx_t))), size);
+	pbx->res = pbx;
+
+	port_sys_unlock();
+
+	return pbx;
+}
+
+/* -------------------------------------------------------------------------- */
+void pbx_kill( pbx_t *pbx )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(pbx);
+
+	port_sys_lock();
+
+	pbx->count = 0; // the heap remains a permutation of the slots
+
+	core_all_wakeup(pbx, E_STOPPED);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void pbx_delete( pbx_t *pbx )
+/* -------------------------------------------------------------------------- */
+{
+	port_sys_lock();
+
+	pbx_kill(pbx);
+	core_sys_free(pbx->res);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pbx_get( pbx_t *pbx, char *data, unsigned *prio )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned num  = priv_pbx_slot(pbx, 0)->heap;
+	pbh_t  * slot = priv_pbx_slot(pbx, num);
+	unsigned last;
+	pbh_t  * tail;
+	unsigned pos  = 0;
+	unsigned nxt;
+
+	memcpy(data, slot + 1, pbx->size);
+	if (prio) *prio = slot->prio;
+
+	last = priv_pbx_slot(pbx, --pbx->count)->heap;
+	tail = priv_pbx_slot(pbx, last);
+
+	while ((nxt = pos * 2 + 1) < pbx->count) // sift down
+	{
+		if (nxt + 1 < pbx->count &&
+		    priv_pbx_before(priv_pbx_slot(pbx, priv_pbx_slot(pbx, nxt + 1)->heap),
+		                    priv_pbx_slot(pbx, priv_pbx_slot(pbx, nxt)->heap)))
+			nxt++;
+		if (!priv_pbx_before(priv_pbx_slot(pbx, priv_pbx_slot(pbx, nxt)->heap), tail))
+			break;
+		priv_pbx_slot(pbx, pos)->heap = priv_pbx_slot(pbx, nxt)->heap;
+		pos = nxt;
+	}
+
+	priv_pbx_slot(pbx, pos)->heap = last;
+	priv_pbx_slot(pbx, pbx->count)->heap = num; // the slot is free now
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pbx_put( pbx_t *pbx, const char *data, unsigned prio )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned num;
+	pbh_t  * slot;
+	unsigned pos;
+	unsigned nxt;
+
+	if (pbx->count == 0 && pbx->seq == 0) // the first mail: the queue may have been defined with a macro, without binding the heap
+		priv_pbx_bind(pbx);               // any permutation of the slots is a valid heap of the empty queue
+
+	num  = priv_pbx_slot(pbx, pbx->count)->heap; // the first free slot
+	slot = priv_pbx_slot(pbx, num);
+	pos  = pbx->count++;
+
+	memcpy(slot + 1, data, pbx->size);
+	slot->prio = prio;
+	slot->seq  = pbx->seq++;
+
+	while (pos > 0) // sift up
+	{
+		nxt = (pos - 1) / 2;
+		if (!priv_pbx_before(slot, priv_pbx_slot(pbx, priv_pbx_slot(pbx, nxt)->heap)))
+			break;
+		priv_pbx_slot(pbx, pos)->heap = priv_pbx_slot(pbx, nxt)->heap;
+		pos = nxt;
+	}
+
+	priv_pbx_slot(pbx, pos)->heap = num;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pbx_getUpdate( pbx_t *pbx, char *data, unsigned *prio )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk;
+
+	priv_pbx_get(pbx, data, prio);
+	tsk = core_one_wakeup(pbx, E_SUCCESS);
+	if (tsk) priv_pbx_put(pbx, tsk->tmp.pbx.data.out, tsk->tmp.pbx.prio);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_pbx_putUpdate( pbx_t *pbx, const char *data, unsigned prio )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk;
+
+	priv_pbx_put(pbx, data, prio);
+	tsk = core_one_wakeup(pbx, E_SUCCESS);
+	if (tsk) priv_pbx_get(pbx, tsk->tmp.pbx.data.in, &tsk->tmp.pbx.prio);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_take( pbx_t *pbx, void *data, unsigned *prio )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(pbx);
+	assert(data);
+
+	port_sys_lock();
+
+	if (pbx->count > 0)
+	{
+		priv_pbx_getUpdate(pbx, data, prio);
+		event = E_SUCCESS;
+	}
+
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_pbx_wait( pbx_t *pbx, void *data, unsigned *prio, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(!port_isr_inside());
+	assert(pbx);
+	assert(data);
+
+	port_sys_lock();
+
+	if (pbx->count > 0)
+	{
+		priv_pbx_getUpdate(pbx, data, prio);
+		event = E_SUCCESS;
+	}
+	else
+	{
+		System.cur->tmp.pbx.data.in = data;
+		event = wait(pbx, time);
+		if (event == E_SUCCESS && prio)
+			*prio = System.cur->tmp.pbx.prio;
+	}
+
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_waitUntil( pbx_t *pbx, void *data, unsigned *prio, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_pbx_wait(pbx, data, prio, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_waitFor( pbx_t *pbx, void *data, unsigned *prio, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_pbx_wait(pbx, data, prio, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_give( pbx_t *pbx, const void *data, unsigned prio )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(pbx);
+	assert(data);
+
+	port_sys_lock();
+
+	if (pbx->count < pbx->limit)
+	{
+		priv_pbx_putUpdate(pbx, data, prio);
+		event = E_SUCCESS;
+	}
+
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_pbx_send( pbx_t *pbx, const void *data, unsigned prio, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(!port_isr_inside());
+	assert(pbx);
+	assert(data);
+
+	port_sys_lock();
+
+	if (pbx->count < pbx->limit)
+	{
+		priv_pbx_putUpdate(pbx, data, prio);
+		event = E_SUCCESS;
+	}
+	else
+	{
+		System.cur->tmp.pbx.data.out = data;
+		System.cur->tmp.pbx.prio = prio;
+		event = wait(pbx, time);
+	}
+
+	port_sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_sendUntil( pbx_t *pbx, const void *data, unsigned prio, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_pbx_send(pbx, data, prio, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_sendFor( pbx_t *pbx, const void *data, unsigned prio, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_pbx_send(pbx, data, prio, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_count( pbx_t *pbx )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	assert(pbx);
+
+	port_sys_lock();
+
+	cnt = pbx->count;
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned pbx_space( pbx_t *pbx )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	assert(pbx);
+
+	port_sys_lock();
+
+	cnt = pbx->limit - pbx->count;
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
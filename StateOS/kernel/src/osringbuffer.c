@@ -0,0 +1,243 @@
+/******************************************************************************
+
+    @file    StateOS: osringbuffer.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/osringbuffer.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+void rng_init( rng_t *rng, unsigned limit, void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(rng);
+	assert(limit);
+	assert(data);
+	assert(size);
+
+	port_sys_lock();
+
+	memset(rng, 0, sizeof(rng_t));
+
+	rng->limit = limit;
+	rng->size  = size;
+	rng->data  = data;
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+rng_t *rng_create( unsigned limit, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	rng_t *rng;
+
+	assert(!port_isr_inside());
+	assert(limit);
+	assert(size);
+
+	port_sys_lock();
+
+	rng = core_sys_alloc(ABOVE(sizeof(rng_t)) + limit * size);
+	rng_init(rng, limit, (void *)((size_t)rng + ABOVE(sizeof(rng_t))), size);
+	rng->res = rng;
+
+	port_sys_unlock();
+
+	return rng;
+}
+
+/* -------------------------------------------------------------------------- */
+void rng_kill( rng_t *rng )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(rng);
+
+	port_sys_lock();
+
+	rng->head = 0;
+	rng->tail = 0;
+
+	core_all_wakeup(rng, E_STOPPED);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void rng_delete( rng_t *rng )
+/* -------------------------------------------------------------------------- */
+{
+	port_sys_lock();
+
+	rng_kill(rng);
+	core_sys_free(rng->res);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_rng_count( rng_t *rng, unsigned head, unsigned tail )
+/* -------------------------------------------------------------------------- */
+{
+	return (tail >= head) ? tail - head : tail + 2 * rng->limit - head;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+char *priv_rng_slot( rng_t *rng, unsigned i )
+/* -------------------------------------------------------------------------- */
+{
+	if (i >= rng->limit) i -= rng->limit;
+
+	return &rng->data[i * rng->size];
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_rng_next( rng_t *rng, unsigned i )
+/* -------------------------------------------------------------------------- */
+{
+	return (++i < 2 * rng->limit) ? i : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rng_take( rng_t *rng, void *data )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned head;
+
+	assert(rng);
+	assert(data);
+
+	head = rng->head;
+	if (head == rng->tail)
+		return E_TIMEOUT;
+
+	__DMB(); // read the element only after its index has been read
+	memcpy(data, priv_rng_slot(rng, head), rng->size);
+	__DMB(); // release the slot only after the element has been read
+	rng->head = priv_rng_next(rng, head);
+
+	return E_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_rng_wait( rng_t *rng, void *data, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(!port_isr_inside());
+	assert(rng);
+	assert(data);
+
+	event = rng_take(rng, data);
+
+	if (event != E_SUCCESS)
+	{
+		port_sys_lock();
+
+		event = (rng->head == rng->tail) ? wait(rng, time) : E_SUCCESS;
+
+		port_sys_unlock();
+
+		if (event == E_SUCCESS)
+			event = rng_take(rng, data);
+	}
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rng_waitUntil( rng_t *rng, void *data, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_rng_wait(rng, data, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rng_waitFor( rng_t *rng, void *data, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_rng_wait(rng, data, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rng_give( rng_t *rng, const void *data )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned tail;
+
+	assert(rng);
+	assert(data);
+
+	tail = rng->tail;
+	if (priv_rng_count(rng, rng->head, tail) >= rng->limit)
+		return E_TIMEOUT;
+
+	memcpy(priv_rng_slot(rng, tail), data, rng->size);
+	__DMB(); // publish the element before its index
+	rng->tail = priv_rng_next(rng, tail);
+	__DMB(); // check the consumer only after the index has been published
+
+	if (rng->queue != 0)
+	{
+		port_sys_lock();
+
+		core_one_wakeup(rng, E_SUCCESS);
+
+		port_sys_unlock();
+	}
+
+	return E_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rng_count( rng_t *rng )
+/* -------------------------------------------------------------------------- */
+{
+	assert(rng);
+
+	return priv_rng_count(rng, rng->head, rng->tail);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rng_space( rng_t *rng )
+/* -------------------------------------------------------------------------- */
+{
+	assert(rng);
+
+	return rng->limit - priv_rng_count(rng, rng->head, rng->tail);
+}
+
+/* -------------------------------------------------------------------------- */
@@ -135,14 +135,20 @@ void priv_stm_get( stm_t *stm, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
 	unsigned i = stm->head;
+	unsigned n = stm->limit - i;
 
-	stm->count -= size;;
-	while (size--)
+	stm->count -= size;
+	if (size < n)
+	{
+		memcpy(data, &stm->data[i], size);
+		stm->head = i + size;
+	}
+	else
 	{
-		*data++ = stm->data[i++];
-		if (i >= stm->limit) i = 0;
+		memcpy(data, &stm->data[i], n);
+		memcpy(data + n, stm->data, size - n);
+		stm->head = size - n;
 	}
-	stm->head = i;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -151,23 +157,27 @@ void priv_stm_put( stm_t *stm, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
 	unsigned i = stm->tail;
+	unsigned n = stm->limit - i;
 
 	stm->count += size;
-	while (size--)
+	if (size < n)
 	{
-		stm->data[i++] = *data++;
-		if (i >= stm->limit) i = 0;
+		memcpy(&stm->data[i], data, size);
+		stm->tail = i + size;
+	}
+	else
+	{
+		memcpy(&stm->data[i], data, n);
+		memcpy(stm->data, data + n, size - n);
+		stm->tail = size - n;
 	}
-	stm->tail = i;
 }
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
+void priv_stm_getWakeup( stm_t *stm )
 /* -------------------------------------------------------------------------- */
 {
-	priv_stm_get(stm, data, size);
-
 	while (stm->queue != 0 && stm->queue->tmp.stm.size <= stm->limit - stm->count)
 	{
 		priv_stm_put(stm, stm->queue->tmp.stm.data.out, stm->queue->tmp.stm.size);
@@ -177,11 +187,9 @@ void priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+void priv_stm_putWakeup( stm_t *stm )
 /* -------------------------------------------------------------------------- */
 {
-	priv_stm_put(stm, data, size);
-
 	while (stm->queue != 0 && stm->count > 0)
 	{
 		if (stm->queue->tmp.stm.size <= stm->count)
@@ -196,6 +204,24 @@ void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
 	}
 }
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	priv_stm_get(stm, data, size);
+	priv_stm_getWakeup(stm);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	priv_stm_put(stm, data, size);
+	priv_stm_putWakeup(stm);
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_take( stm_t *stm, void *data, unsigned size )
 /* -------------------------------------------------------------------------- */
@@ -366,6 +392,102 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned stm_reserve( stm_t *stm, void **data )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	assert(stm);
+	assert(data);
+
+	port_sys_lock();
+
+	if (stm->count == 0)
+	{
+		stm->head = 0;
+		stm->tail = 0;
+	}
+
+	cnt = priv_stm_space(stm);
+	if (cnt > stm->limit - stm->tail)
+		cnt = stm->limit - stm->tail;
+	*data = &stm->data[stm->tail];
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+void stm_commit( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	bool readers;
+
+	assert(stm);
+
+	port_sys_lock();
+
+	if (size > 0)
+	{
+		assert(size <= stm->limit - stm->count);
+		assert(size <= stm->limit - stm->tail);
+
+		readers = stm->count == 0; // only readers wait for the empty stream buffer, writers may wait for the reserved space
+
+		stm->count += size;
+		stm->tail  += size;
+		if (stm->tail >= stm->limit) stm->tail = 0;
+
+		if (readers)
+			priv_stm_putWakeup(stm);
+	}
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_peek( stm_t *stm, void **data )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	assert(stm);
+	assert(data);
+
+	port_sys_lock();
+
+	cnt = priv_stm_count(stm);
+	if (cnt > stm->limit - stm->head)
+		cnt = stm->limit - stm->head;
+	*data = &stm->data[stm->head];
+
+	port_sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+void stm_consume( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(stm);
+
+	port_sys_lock();
+
+	if (size > 0)
+	{
+		assert(size <= priv_stm_count(stm));
+		assert(size <= stm->limit - stm->head);
+
+		priv_stm_skip(stm, size);
+		priv_stm_getWakeup(stm);
+	}
+
+	port_sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_count( stm_t *stm )
 /* -------------------------------------------------------------------------- */
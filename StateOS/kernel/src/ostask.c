@@ -57,6 +57,17 @@ void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned si
 	port_sys_unlock();
 }
 
+#if OS_SRP_STACK
+
+/* -------------------------------------------------------------------------- */
+void srp_init( tsk_t *tsk, unsigned prio, fun_t *state )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_init(tsk, prio, state, SRP_STK, OS_SRP_STACK);
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size )
 /* -------------------------------------------------------------------------- */
@@ -124,16 +135,10 @@ void tsk_stop( void )
 /* -------------------------------------------------------------------------- */
 {
 	assert(!port_isr_inside());
-	assert(!System.cur->mtx.list);
 
 	port_set_lock();
 
-	if (System.cur->join != DETACHED)
-		core_tsk_wakeup(System.cur->join, E_SUCCESS);
-	else
-		core_sys_free(System.cur->obj.res);
-
-	core_tsk_remove(System.cur);
+	core_tsk_stop();
 
 	for (;;);
 }
@@ -144,11 +149,15 @@ void tsk_kill( tsk_t *tsk )
 {
 	assert(!port_isr_inside());
 	assert(tsk);
+	assert(tsk != System.cur || System.lock == 0); // the current task can not be killed while the scheduler is locked
 
 	port_sys_lock();
 
 	if (tsk->id != ID_STOPPED)
 	{
+		while (tsk->pcm)
+			pcm_kill(tsk->pcm);
+
 		tsk->mtx.tree = 0;
 		while (tsk->mtx.list)
 			mtx_kill(tsk->mtx.list);
@@ -243,12 +252,44 @@ void tsk_yield( void )
 
 	port_sys_lock();
 
-	core_ctx_switch();
+	core_ctx_yield();
 
 	port_clr_lock();
 	port_sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+void tsk_lock( void )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+
+	port_sys_lock();
+
+	assert(System.lock + 1);
+	System.lock++;
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void tsk_unlock( void )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+
+	port_sys_lock();
+
+	assert(System.lock);
+	if (--System.lock == 0 && (System.pend || System.cur != IDLE.obj.next))
+	{
+		System.pend = 0;
+		port_ctx_switch(); // deferred context switch (or round-robin rotation), performed when interrupts are enabled
+	}
+
+	port_sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void tsk_flip( fun_t *state )
 /* -------------------------------------------------------------------------- */
@@ -260,7 +301,7 @@ void tsk_flip( fun_t *state )
 
 	System.cur->state = state;
 
-	core_ctx_switch();
+	core_ctx_yield();
 	core_tsk_flip(System.cur->top);
 }
 
@@ -278,6 +319,72 @@ void tsk_prio( unsigned prio )
 	port_sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned srp_lock( unsigned ceiling )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned prio;
+
+	assert(!port_isr_inside());
+
+	port_sys_lock();
+
+	prio = System.cur->basic;
+
+	if (ceiling > prio)
+	{
+		System.cur->basic = ceiling;
+		core_cur_prio(ceiling);
+	}
+
+	port_sys_unlock();
+
+	return prio;
+}
+
+#if OS_TASK_STATS
+
+/* -------------------------------------------------------------------------- */
+void tsk_getStats( tsk_t *tsk, tst_t *stat )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(tsk);
+	assert(stat);
+
+	port_sys_lock();
+
+	*stat = tsk->stat;
+	if (tsk == System.cur)  // add run time of the current time slice
+		stat->time += port_cyc_get() - tsk->cyc;
+
+	port_sys_unlock();
+}
+
+#endif
+
+#if OS_STACK_PAINT
+
+/* -------------------------------------------------------------------------- */
+unsigned tsk_stackUsage( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned size;
+
+	assert(!port_isr_inside());
+	assert(tsk);
+
+	port_sys_lock();
+
+	size = core_stk_scan(tsk); // the scan starts below the mark recorded before (e.g. by the idle task)
+
+	port_sys_unlock();
+
+	return size;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 static
 unsigned priv_tsk_wait( unsigned flags, cnt_t time, unsigned(*wait)(void*,cnt_t) )
@@ -77,6 +77,9 @@ void tmr_kill( tmr_t *tmr )
 
 	if (tmr->id != ID_STOPPED)
 	{
+#if OS_TIMER_TASK
+		tmr->gen++;
+#endif
 		core_all_wakeup(tmr, E_STOPPED);
 		core_tmr_remove(tmr);
 	}
@@ -103,6 +106,10 @@ void priv_tmr_start( tmr_t *tmr )
 {
 	assert(!port_isr_inside());
 
+#if OS_TIMER_TASK
+	core_tmr_service();
+	tmr->gen++;
+#endif
 	if (tmr->id != ID_STOPPED)
 		core_tmr_remove(tmr);
 	core_tmr_insert(tmr, ID_TIMER);
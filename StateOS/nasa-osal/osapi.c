@@ -56,6 +56,10 @@
 #include <stdio.h>
 #include <osnasa.h>
 
+#if     OS_PRIO_LEVELS
+#error  osconfig.h: nasa-osal requires OS_PRIO_LEVELS == 0 (task priorities are inverted)!
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*
 ** OSAL internal data
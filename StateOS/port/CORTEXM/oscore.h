@@ -133,6 +133,16 @@ void port_ctx_init( ctx_t *ctx, fun_t *pc )
 	ctx->psr = 0x01000000;
 }
 
+/* -------------------------------------------------------------------------- */
+// return the top of the free stack below the saved task context 'sp'
+// the whole context is saved above 'sp'
+
+__STATIC_INLINE
+void *port_ctx_below( void *sp )
+{
+	return sp;
+}
+
 /* -------------------------------------------------------------------------- */
 
 #if   defined(__CSMC__)
@@ -229,6 +239,131 @@ void port_ctx_switchLock( void )
 	port_set_lock();
 }
 
+/* -------------------------------------------------------------------------- */
+// atomic compare and swap of the word, used by the lock-free algorithms
+// return true if the value 'cmp' was replaced with the value 'val'
+
+__STATIC_INLINE
+bool port_cas_word( volatile uint32_t *ptr, uint32_t cmp, uint32_t val )
+{
+#if __CORTEX_M >= 3 && !defined(__CSMC__)
+	do
+	{
+		if (__LDREXW(ptr) != cmp)
+		{
+			__CLREX();
+			return false;
+		}
+	}
+	while (__STREXW(val, ptr));
+	__DMB();
+	return true;
+#else
+	bool  res;
+	lck_t lck = port_get_lock();
+	port_set_lock();
+	res = (*ptr == cmp);
+	if (res) *ptr = val;
+	port_put_lock(lck);
+	return res;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+// floating-point context of the task
+
+#if __FPU_USED
+// does the saved context of the task contain the floating-point registers (the extended frame)?
+__STATIC_INLINE
+bool port_ctx_fpu( ctx_t *ctx )
+{
+	return (ctx->lr & 0x10U) == 0U; // EXC_RETURN: bit 4 is cleared for the extended frame
+}
+#endif
+
+// release the floating-point context of the current task (CONTROL.FPCA),
+// so the next context switch saves the short frame until the task uses the floating-point unit again
+__STATIC_INLINE
+void port_fpu_reset( void )
+{
+#if __FPU_USED
+	__set_CONTROL(__get_CONTROL() & ~CONTROL_FPCA_Msk);
+	__ISB();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+// cycle counter used by the tasks' run-time statistics and the kernel trace
+
+#if OS_TASK_STATS || OS_TRACE
+
+__STATIC_INLINE
+void port_cyc_init( void )
+{
+#if __CORTEX_M >= 3
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+__STATIC_INLINE
+uint32_t port_cyc_get( void )
+{
+#if __CORTEX_M >= 3
+	return DWT->CYCCNT;
+#else
+	return 0; // cycle counter is not available
+#endif
+}
+
+#endif//OS_TASK_STATS || OS_TRACE
+
+/* -------------------------------------------------------------------------- */
+// MPU guard region at the bottom of the current task's stack
+
+#if OS_STACK_GUARD
+
+#if     !defined(__MPU_PRESENT) || (__MPU_PRESENT == 0)
+#error  osconfig.h: OS_STACK_GUARD requires the MPU!
+#endif
+
+#if     (OS_STACK_GUARD) < 32 || ((OS_STACK_GUARD) & ((OS_STACK_GUARD)-1))
+#error  osconfig.h: Incorrect OS_STACK_GUARD value! Must be a power of 2 and not less than 32.
+#endif
+
+#define STK_GUARD_REGION    7U // the highest region number, it takes precedence over the regions of the application
+
+// the lowest address of the stack available for the task, above the guard region
+#define port_stk_limit(stack)         (void *)((((size_t)(stack)+(OS_STACK_GUARD)-1)&~(size_t)((OS_STACK_GUARD)-1))+(OS_STACK_GUARD))
+
+__STATIC_INLINE
+void port_stk_init( void )
+{
+	MPU->RNR   = STK_GUARD_REGION;
+	MPU->RBAR  = 0U;
+	MPU->RASR  = 0U;               // the main task uses the system stack and is not protected
+	MPU->CTRL  = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+#if __CORTEX_M >= 3
+	SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+#endif
+	__DSB();
+	__ISB();
+}
+
+// called by the context switch handler, the exception return completes the change of the region
+__STATIC_INLINE
+void port_stk_guard( void *stack )
+{
+	uint32_t base = (uint32_t)((size_t)port_stk_limit(stack) - (OS_STACK_GUARD));
+
+	MPU->RBAR = base | MPU_RBAR_VALID_Msk | STK_GUARD_REGION;
+	MPU->RASR = stack == 0 ? 0U : MPU_RASR_XN_Msk | ((30U - __CLZ(OS_STACK_GUARD)) << MPU_RASR_SIZE_Pos) | MPU_RASR_ENABLE_Msk;
+	__DSB();
+}
+
+#endif//OS_STACK_GUARD
+
 /* -------------------------------------------------------------------------- */
 
 #ifdef __cplusplus
@@ -0,0 +1,176 @@
+/******************************************************************************
+
+    @file    StateOS: oscore.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   StateOS port file for POSIX (Linux host).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include <ostask.h>
+#include <signal.h>
+#include <ucontext.h>
+
+/* -------------------------------------------------------------------------- */
+
+volatile lck_t port_lck_state = 0;
+volatile bool  port_isr_state = false;
+
+// context of the task started on the fresh stack
+static ucontext_t Boot;
+
+/* -------------------------------------------------------------------------- */
+// set of the signals emulating the interrupts
+
+static
+void priv_sig_set( sigset_t *set )
+{
+	sigemptyset(set);
+	sigaddset(set, OS_SIG_TIMER);
+	sigaddset(set, OS_SIG_ROBIN);
+	sigaddset(set, OS_SIG_SWITCH);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_set_lock( void )
+{
+	sigset_t set;
+
+	if (port_lck_state) return;
+
+	if (!port_isr_state)
+	{
+		priv_sig_set(&set);
+		sigprocmask(SIG_BLOCK, &set, 0);
+	}
+
+	port_lck_state = 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_clr_lock( void )
+{
+	sigset_t set;
+
+	if (!port_lck_state) return;
+
+	port_lck_state = 0;
+
+	if (!port_isr_state)
+	{
+		priv_sig_set(&set);
+		sigprocmask(SIG_UNBLOCK, &set, 0);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_switch( void )
+{
+	raise(OS_SIG_SWITCH);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void __WFI( void )
+{
+	sigset_t set;
+
+	sigprocmask(SIG_BLOCK, 0, &set);
+	sigdelset(&set, OS_SIG_TIMER);
+	sigdelset(&set, OS_SIG_ROBIN);
+	sigdelset(&set, OS_SIG_SWITCH);
+	sigsuspend(&set);
+}
+
+/* -------------------------------------------------------------------------- */
+// start the current task at the top 'sp' of its stack
+// the signals remain blocked until the task loop clears the lock
+
+static
+void priv_ctx_boot( void *sp, ucontext_t *uc )
+{
+	tsk_t *cur = System.cur;
+	char  *stk = cur->stack ? cur->stack : (char *) cur->top - ABOVE(OS_STACK_SIZE);
+
+	getcontext(&Boot);
+	Boot.uc_stack.ss_sp   = stk;
+	Boot.uc_stack.ss_size = (size_t) sp - (size_t) stk;
+	Boot.uc_link          = 0;
+	makecontext(&Boot, core_tsk_loop, 0);
+
+	port_lck_state = 1;
+
+	if (uc)
+		swapcontext(uc, &Boot);
+	else
+		setcontext(&Boot);
+}
+
+/* -------------------------------------------------------------------------- */
+// emulated PendSV handler
+
+void port_ctx_handler( int signo )
+{
+	lck_t      lck = port_lck_state;
+	ucontext_t uc;
+	ctx_t      ctx = _CTX_INIT(0);
+	ctx_t    * nxt;
+
+	(void) signo;
+
+	port_lck_state = 0;
+	port_isr_state = true;
+
+	ctx.uc = &uc;
+	nxt = core_tsk_handler(&ctx);
+
+	if (nxt != &ctx)
+	{
+		port_isr_state = false;
+
+		if (nxt->pc)
+			priv_ctx_boot(nxt, &uc);
+		else
+			swapcontext(&uc, nxt->uc);
+
+		port_isr_state = true;
+	}
+
+	port_isr_state = false;
+	port_lck_state = lck;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_flip( void *sp )
+{
+	priv_ctx_boot(sp, 0);
+	for (;;);
+}
+
+/* -------------------------------------------------------------------------- */
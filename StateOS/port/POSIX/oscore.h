@@ -0,0 +1,254 @@
+/******************************************************************************
+
+    @file    StateOS: oscore.h
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   StateOS port file for POSIX (Linux host).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSCORE_H
+#define __STATEOSCORE_H
+
+#include <osbase.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_HEAP_SIZE
+#define OS_HEAP_SIZE          0 /* default system heap: all free memory       */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// every stack of the host must also hold the frames of the signal handlers
+// and of the C library, so the stack sizes configured for the target are
+// replaced with the sizes suitable for the host
+
+#undef  OS_STACK_SIZE
+#define OS_STACK_SIZE     65536 /* default task stack size in bytes           */
+
+#undef  OS_IDLE_STACK
+#define OS_IDLE_STACK     16384 /* idle task stack size in bytes              */
+
+#if     OS_SRP_STACK
+#undef  OS_SRP_STACK
+#define OS_SRP_STACK     262144 /* size of the stack shared by run-to-completion tasks */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_MAIN_PRIO
+#define OS_MAIN_PRIO          0 /* priority of main process                   */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  __cplusplus
+
+#ifndef OS_FUNCTIONAL
+#define OS_FUNCTIONAL         1 /* include c++ functional library header      */
+#endif
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+typedef uint32_t              lck_t;
+typedef uint64_t              stk_t;
+
+/* -------------------------------------------------------------------------- */
+// task context
+// the registers of the task are saved by the context switch handler
+// in the ucontext structure placed on the stack of the task
+
+typedef struct __ctx ctx_t;
+
+struct __ctx
+{
+	fun_t      * pc; // entry point of the new task, 0 if the context has been saved
+	struct
+	ucontext_t * uc; // saved context of the task
+};
+
+#define _CTX_INIT( pc ) { pc, 0 }
+
+/* -------------------------------------------------------------------------- */
+// init task context
+
+__STATIC_INLINE
+void port_ctx_init( ctx_t *ctx, fun_t *pc )
+{
+	ctx->pc = pc;
+	ctx->uc = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+// return the top of the free stack below the saved task context 'sp'
+// the saved registers (ucontext structure) and the frames of the emulated context switch are placed below 'sp'
+
+__STATIC_INLINE
+void *port_ctx_below( void *sp )
+{
+	return (char *) sp - 8192;
+}
+
+/* -------------------------------------------------------------------------- */
+// emulated state of the processor
+
+extern volatile lck_t port_lck_state; // signals emulating the interrupts are blocked
+extern volatile bool  port_isr_state; // procedure is inside the signal handler
+
+/* -------------------------------------------------------------------------- */
+// is procedure inside ISR?
+
+__STATIC_INLINE
+bool port_isr_inside( void )
+{
+	return port_isr_state;
+}
+
+/* -------------------------------------------------------------------------- */
+// are interrupts masked?
+
+__STATIC_INLINE
+bool port_isr_masked( void )
+{
+	return port_lck_state != 0U;
+}
+
+/* -------------------------------------------------------------------------- */
+// get current stack pointer
+
+__STATIC_INLINE
+void * port_get_sp( void )
+{
+	return __builtin_frame_address(0);
+}
+
+/* -------------------------------------------------------------------------- */
+// block / unblock the signals emulating the interrupts
+// inside the signal handler only the lock state is changed,
+// all the other signals remain blocked until the handler returns
+
+void port_set_lock( void );
+void port_clr_lock( void );
+
+#define port_get_lock()     port_lck_state
+#define port_put_lock(lck)  do { if (lck) port_set_lock(); else port_clr_lock(); } while(0)
+
+#define port_sys_lock()  do { lck_t __LOCK = port_get_lock(); port_set_lock()
+#define port_sys_unlock()     port_put_lock(__LOCK); } while(0)
+
+#define port_isr_lock()  do { port_set_lock()
+#define port_isr_unlock()     port_clr_lock(); } while(0)
+
+#define port_set_barrier()  __ISB()
+
+/* -------------------------------------------------------------------------- */
+
+#define __disable_irq()     port_set_lock()
+#define __enable_irq()      port_clr_lock()
+
+/* -------------------------------------------------------------------------- */
+// wait for the signal emulating the interrupt
+
+void __WFI( void );
+
+/* -------------------------------------------------------------------------- */
+
+__STATIC_INLINE
+void port_ctx_switchNow( void )
+{
+	port_ctx_switch();
+	port_clr_lock();
+	port_set_barrier();
+}
+
+/* -------------------------------------------------------------------------- */
+
+__STATIC_INLINE
+void port_ctx_switchLock( void )
+{
+	port_ctx_switchNow();
+	port_set_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+// atomic compare and swap of the word, used by the lock-free algorithms
+// return true if the value 'cmp' was replaced with the value 'val'
+
+__STATIC_INLINE
+bool port_cas_word( volatile uint32_t *ptr, uint32_t cmp, uint32_t val )
+{
+	return __sync_bool_compare_and_swap(ptr, cmp, val);
+}
+
+/* -------------------------------------------------------------------------- */
+// floating-point context of the task is kept by the host
+
+__STATIC_INLINE
+void port_fpu_reset( void )
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if     OS_STACK_GUARD
+#error  osconfig.h: OS_STACK_GUARD is not supported by the POSIX port!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// cycle counter used by the tasks' run-time statistics and the kernel trace
+
+#if OS_TASK_STATS || OS_TRACE
+
+__STATIC_INLINE
+void port_cyc_init( void )
+{
+}
+
+__STATIC_INLINE
+uint32_t port_cyc_get( void )
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	// cycles of the emulated core clock (CPU_FREQUENCY)
+	return (uint32_t)((uint64_t) ts.tv_sec * (CPU_FREQUENCY) + (uint64_t) ts.tv_nsec * (CPU_FREQUENCY) / 1000000000U);
+}
+
+#endif//OS_TASK_STATS || OS_TRACE
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__STATEOSCORE_H
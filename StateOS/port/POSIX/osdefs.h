@@ -0,0 +1,68 @@
+/******************************************************************************
+
+    @file    StateOS: osdefs.h
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   StateOS port file for POSIX (Linux host).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSDEFS_H
+#define __STATEOSDEFS_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+// substitutes for the CMSIS compiler definitions used by the kernel
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE     static inline
+#endif
+
+#ifndef __NO_RETURN
+#define __NO_RETURN         __attribute__((__noreturn__))
+#endif
+
+#ifndef __CONSTRUCTOR
+#define __CONSTRUCTOR       __attribute__((constructor))
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+__STATIC_INLINE
+uint32_t __CLZ( uint32_t value )
+{
+	return value ? (uint32_t) __builtin_clz(value) : 32U;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#define __DMB()             __sync_synchronize()
+#define __DSB()             __sync_synchronize()
+#define __ISB()             __asm__ volatile ("" ::: "memory")
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOSDEFS_H
@@ -0,0 +1,98 @@
+/******************************************************************************
+
+    @file    StateOS: oslibc.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   StateOS port file for POSIX (Linux host).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include <oskernel.h>
+
+/* -------------------------------------------------------------------------- */
+// the heap of the C library is not reentrant: a task preempted inside malloc
+// would deadlock the next task calling it, so the heap functions are wrapped
+// (see the --wrap linker options in makefile.host) and called with the lock set
+
+void *__real_malloc ( size_t size );
+void *__real_calloc ( size_t num, size_t size );
+void *__real_realloc( void *ptr, size_t size );
+void  __real_free   ( void *ptr );
+
+/* -------------------------------------------------------------------------- */
+
+void *__wrap_malloc( size_t size )
+{
+	void *ptr;
+
+	port_sys_lock();
+
+	ptr = __real_malloc(size);
+
+	port_sys_unlock();
+
+	return ptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *__wrap_calloc( size_t num, size_t size )
+{
+	void *ptr;
+
+	port_sys_lock();
+
+	ptr = __real_calloc(num, size);
+
+	port_sys_unlock();
+
+	return ptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void *__wrap_realloc( void *ptr, size_t size )
+{
+	port_sys_lock();
+
+	ptr = __real_realloc(ptr, size);
+
+	port_sys_unlock();
+
+	return ptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void __wrap_free( void *ptr )
+{
+	port_sys_lock();
+
+	__real_free(ptr);
+
+	port_sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
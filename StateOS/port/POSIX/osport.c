@@ -0,0 +1,396 @@
+/******************************************************************************
+
+    @file    StateOS: osport.c
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   StateOS port file for POSIX (Linux host).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include <oskernel.h>
+#include <signal.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define NSEC   1000000000ULL        // nanoseconds per second
+#define PERIOD (NSEC/(OS_FREQUENCY)) // nanoseconds per tick
+
+#if HW_TIMER_SIZE
+uint64_t port_tck_base = 0;
+#endif
+
+static timer_t Timer; // emulated system timer
+#if HW_TIMER_SIZE && OS_ROBIN
+static timer_t Robin; // emulated timer for context switch triggering
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_set( timer_t tmr, uint64_t value, uint64_t interval )
+{
+	struct itimerspec its;
+
+	its.it_value.tv_sec     = (time_t)(value / NSEC);
+	its.it_value.tv_nsec    = (long)  (value % NSEC);
+	its.it_interval.tv_sec  = (time_t)(interval / NSEC);
+	its.it_interval.tv_nsec = (long)  (interval % NSEC);
+
+	timer_settime(tmr, 0, &its, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_sig_init( int signo, void (*handler)( int ) )
+{
+	struct sigaction sa;
+
+	sa.sa_handler = handler;
+	sa.sa_flags   = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaddset(&sa.sa_mask, OS_SIG_TIMER);
+	sigaddset(&sa.sa_mask, OS_SIG_ROBIN);
+	sigaddset(&sa.sa_mask, OS_SIG_SWITCH);
+	sigaction(signo, &sa, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_init( timer_t *tmr, int signo )
+{
+	struct sigevent se;
+
+	se.sigev_notify = SIGEV_SIGNAL;
+	se.sigev_signo  = signo;
+	se.sigev_value.sival_ptr = tmr;
+	timer_create(CLOCK_MONOTONIC, &se, tmr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_handler( int signo );
+
+static void priv_tmr_handler( int signo );
+#if HW_TIMER_SIZE && OS_ROBIN
+static void priv_rbn_handler( int signo );
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+void port_sys_init( void )
+{
+/******************************************************************************
+ Make sure that the system timer has not yet been initialized
+ This is only needed for compilers supporting the "constructor" function attribute or its equivalent
+*******************************************************************************/
+
+	static bool init = false;
+
+	if (init) return;
+
+	init = true;
+
+/******************************************************************************
+ End of check
+*******************************************************************************/
+
+/******************************************************************************
+ Configuration of signal for context switch
+*******************************************************************************/
+
+	priv_sig_init(OS_SIG_SWITCH, port_ctx_handler);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#if HW_TIMER_SIZE == 0
+
+/******************************************************************************
+ Non-tick-less mode: configuration of system timer
+ It must generate signals with frequency OS_FREQUENCY
+*******************************************************************************/
+
+	priv_sig_init(OS_SIG_TIMER, priv_tmr_handler);
+	priv_tmr_init(&Timer, OS_SIG_TIMER);
+	priv_tmr_set(Timer, PERIOD, PERIOD);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#else //HW_TIMER_SIZE
+
+/******************************************************************************
+ Tick-less mode: configuration of system timer
+ It counts the ticks of the monotonic clock since the system start
+*******************************************************************************/
+
+	port_tck_base = port_sys_time();
+	priv_sig_init(OS_SIG_TIMER, priv_tmr_handler);
+	priv_tmr_init(&Timer, OS_SIG_TIMER);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+	#if OS_ROBIN
+
+/******************************************************************************
+ Tick-less mode with preemption: configuration of timer for context switch triggering
+ It must generate signals with frequency OS_ROBIN
+*******************************************************************************/
+
+	priv_sig_init(OS_SIG_ROBIN, priv_rbn_handler);
+	priv_tmr_init(&Robin, OS_SIG_ROBIN);
+	priv_tmr_set(Robin, NSEC/(OS_ROBIN), NSEC/(OS_ROBIN));
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+	#endif//OS_ROBIN
+
+#endif//HW_TIMER_SIZE
+
+#if OS_TASK_STATS || OS_TRACE
+
+/******************************************************************************
+ Configuration of cycle counter for tasks' run-time statistics and kernel trace
+*******************************************************************************/
+
+	port_cyc_init();
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif//OS_TASK_STATS || OS_TRACE
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_reset( void )
+{
+#if HW_TIMER_SIZE
+	#if OS_ROBIN
+	priv_tmr_set(Robin, NSEC/(OS_ROBIN), NSEC/(OS_ROBIN));
+	#endif
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_tck_suspend( void )
+{
+#if HW_TIMER_SIZE == 0
+	priv_tmr_set(Timer, 0, 0);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_tck_resume( void )
+{
+#if HW_TIMER_SIZE == 0
+	priv_tmr_set(Timer, PERIOD, PERIOD);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_tmr_stop( void )
+{
+#if HW_TIMER_SIZE
+	priv_tmr_set(Timer, 0, 0);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_tmr_start( uint64_t timeout )
+{
+#if HW_TIMER_SIZE
+	struct timespec ts;
+	uint64_t now   = port_sys_time();
+	uint64_t delay = (cnt_t)(timeout - now);
+	uint64_t time;
+
+	if (delay > (OS_FREQUENCY))
+		delay = (OS_FREQUENCY); // the breakpoint is set again after the spurious signal
+
+	time  = now + port_tck_base + delay; // monotonic time of the breakpoint in ticks
+	time  = time / (OS_FREQUENCY) * NSEC + (time % (OS_FREQUENCY) * NSEC + (OS_FREQUENCY) - 1) / (OS_FREQUENCY);
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now   = (uint64_t) ts.tv_sec * NSEC + (uint64_t) ts.tv_nsec;
+
+	priv_tmr_set(Timer, time > now ? time - now : 1, 0);
+#else
+	(void) timeout;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_tmr_force( void )
+{
+#if HW_TIMER_SIZE
+	raise(OS_SIG_TIMER);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if HW_TIMER_SIZE == 0
+
+/******************************************************************************
+ Non-tick-less mode: signal handler of system timer
+*******************************************************************************/
+
+static
+void priv_tmr_handler( int signo )
+{
+	lck_t lck = port_lck_state;
+
+	(void) signo;
+
+	port_lck_state = 0;
+	port_isr_state = true;
+
+	core_sys_tick();
+
+	port_isr_state = false;
+	port_lck_state = lck;
+}
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+#if OS_TICK_SUPPRESS
+
+/******************************************************************************
+ Non-tick-less mode: sleep with suppressed signals of system timer
+ It is called by the idle task with all signals blocked
+ Nothing but the system timer wakes up the idle task on the host,
+ so the sleep always lasts until the deadline
+*******************************************************************************/
+
+cnt_t port_sys_sleep( cnt_t delay )
+{
+	struct itimerspec its;
+	struct timespec   ts;
+	sigset_t          set;
+	uint64_t          left;
+
+	if (delay > (OS_FREQUENCY))
+		delay = (OS_FREQUENCY);
+
+	timer_gettime(Timer, &its);          // time remaining to the end of the current tick
+	left = (uint64_t) its.it_value.tv_sec * NSEC + (uint64_t) its.it_value.tv_nsec;
+
+	sigpending(&set);
+	if (delay < 2 || left == 0 || sigismember(&set, OS_SIG_TIMER))
+		return 0;                        // nothing to suppress or the current tick has already ended
+
+	priv_tmr_set(Timer, 0, 0);
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	left += (uint64_t) ts.tv_sec * NSEC + (uint64_t) ts.tv_nsec + (uint64_t)(delay - 1) * PERIOD;
+	ts.tv_sec  = (time_t)(left / NSEC);
+	ts.tv_nsec = (long)  (left % NSEC);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0));
+
+	priv_tmr_set(Timer, 1, PERIOD);      // deadline reached, the signal of system timer is pending
+
+	return delay - 1;
+}
+
+/******************************************************************************
+ End of the procedure
+*******************************************************************************/
+
+#endif//OS_TICK_SUPPRESS
+
+#else //HW_TIMER_SIZE
+
+/******************************************************************************
+ Tick-less mode: signal handler of system timer
+*******************************************************************************/
+
+static
+void priv_tmr_handler( int signo )
+{
+	lck_t lck = port_lck_state;
+
+	(void) signo;
+
+	port_lck_state = 0;
+	port_isr_state = true;
+
+	core_tmr_handler();
+
+	port_isr_state = false;
+	port_lck_state = lck;
+}
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+	#if OS_ROBIN
+
+/******************************************************************************
+ Tick-less mode with preemption: signal handler for context switch triggering
+*******************************************************************************/
+
+static
+void priv_rbn_handler( int signo )
+{
+	lck_t lck = port_lck_state;
+
+	(void) signo;
+
+	port_lck_state = 0;
+	port_isr_state = true;
+
+	core_ctx_switch();
+
+	port_isr_state = false;
+	port_lck_state = lck;
+}
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+	#endif//OS_ROBIN
+
+#endif//HW_TIMER_SIZE
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,164 @@
+/******************************************************************************
+
+    @file    StateOS: osport.h
+    @author  Rajmund Szymanski
+    @date    13.06.2018
+    @brief   StateOS port definitions for POSIX (Linux host).
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSPORT_H
+#define __STATEOSPORT_H
+
+#include <time.h>
+#ifndef   NOCONFIG
+#include <osconfig.h>
+#endif
+#include <osdefs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the cycle counter of the host counts nanoseconds
+
+#ifndef CPU_FREQUENCY
+#define CPU_FREQUENCY 1000000000 /* Hz */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_FREQUENCY
+#define OS_FREQUENCY       1000 /* Hz */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TIMER_SIZE
+#define OS_TIMER_SIZE        32 /* bit size of system timer counter           */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the hardware timer is emulated with the monotonic clock of the host
+// so it always has the size of the system timer counter
+
+#ifdef  HW_TIMER_SIZE
+#error  HW_TIMER_SIZE is an internal os definition!
+#elif   OS_FREQUENCY > 1000 
+#define HW_TIMER_SIZE OS_TIMER_SIZE /* bit size of hardware timer             */
+#else
+#define HW_TIMER_SIZE         0 /* os does not work in tick-less mode         */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_ROBIN
+#define OS_ROBIN              0 /* system works in cooperative mode           */
+#endif
+
+#if     OS_ROBIN > OS_FREQUENCY
+#error  osconfig.h: Incorrect OS_ROBIN value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// signals emulating the interrupts of the processor
+// the port headers don't include <signal.h> because of the sig_t type of the C library
+
+#ifndef OS_SIG_TIMER
+#define OS_SIG_TIMER    SIGALRM /* system timer (SysTick / TIM2)              */
+#endif
+
+#ifndef OS_SIG_ROBIN
+#define OS_SIG_ROBIN    SIGUSR2 /* context switch timer in tick-less mode     */
+#endif
+
+#ifndef OS_SIG_SWITCH
+#define OS_SIG_SWITCH   SIGUSR1 /* context switch (PendSV)                    */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// return current system time
+
+#if HW_TIMER_SIZE >= OS_TIMER_SIZE
+
+extern uint64_t port_tck_base; // monotonic time of the system start in ticks
+
+__STATIC_INLINE
+uint64_t port_sys_time( void )
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t) ts.tv_sec * (OS_FREQUENCY) + (uint64_t) ts.tv_nsec * (OS_FREQUENCY) / 1000000000U - port_tck_base;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// force yield system control to the next process
+
+void port_ctx_switch( void );
+
+/* -------------------------------------------------------------------------- */
+// reset context switch indicator
+
+void port_ctx_reset( void );
+
+/* -------------------------------------------------------------------------- */
+// stop the system timer (non-tick-less mode)
+
+void port_tck_suspend( void );
+
+/* -------------------------------------------------------------------------- */
+// restart the system timer with a full tick period (non-tick-less mode)
+
+void port_tck_resume( void );
+
+/* -------------------------------------------------------------------------- */
+// clear time breakpoint
+
+void port_tmr_stop( void );
+
+/* -------------------------------------------------------------------------- */
+// set time breakpoint
+
+void port_tmr_start( uint64_t timeout );
+
+/* -------------------------------------------------------------------------- */
+// force timer interrupt
+
+void port_tmr_force( void );
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOSPORT_H
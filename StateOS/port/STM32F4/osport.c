@@ -144,6 +144,50 @@ void port_sys_init( void )
 /******************************************************************************
  End of configuration
 *******************************************************************************/
+
+#if OS_TASK_STATS || OS_TRACE
+
+/******************************************************************************
+ Configuration of cycle counter for tasks' run-time statistics and kernel trace
+*******************************************************************************/
+
+	port_cyc_init();
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif//OS_TASK_STATS || OS_TRACE
+
+#if __FPU_USED
+
+/******************************************************************************
+ Configuration of lazy stacking of the floating-point context
+ Exception entry reserves space for the floating-point registers only when CONTROL.FPCA is set,
+ and the registers are saved only when the handler uses the floating-point unit
+*******************************************************************************/
+
+	FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif//__FPU_USED
+
+#if OS_STACK_GUARD
+
+/******************************************************************************
+ Configuration of MPU for the guard region of the current task's stack
+*******************************************************************************/
+
+	port_stk_init();
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif//OS_STACK_GUARD
 }
 
 /* -------------------------------------------------------------------------- */
@@ -164,6 +208,75 @@ void SysTick_Handler( void )
  End of the handler
 *******************************************************************************/
 
+#if OS_TICK_SUPPRESS
+
+/******************************************************************************
+ Non-tick-less mode: sleep with suppressed interrupts of system timer
+ It is called by the idle task with all interrupts disabled
+*******************************************************************************/
+
+cnt_t port_sys_sleep( cnt_t delay )
+{
+	uint32_t period = SysTick->LOAD + 1; // number of counts per tick
+	uint32_t ticks  = SysTick_LOAD_RELOAD_Msk / period;
+	uint32_t count, load, done, ctrl;
+
+	if (delay < ticks)
+		ticks = (uint32_t) delay;
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	count = SysTick->VAL;                // counts remaining to the end of the current tick
+
+	if (ticks < 2 || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+	{                                    // nothing to suppress or the current tick has already ended
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		return 0;
+	}
+
+	load = count + (ticks - 1) * period; // the last tick ends at the deadline
+	SysTick->LOAD  = load;
+	SysTick->VAL   = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	__DSB();
+	__WFI();
+
+	ctrl = SysTick->CTRL;                // reading clears the COUNTFLAG bit
+	SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+	if (ctrl & SysTick_CTRL_COUNTFLAG_Msk)
+	{                                    // deadline reached, the interrupt of system timer is pending
+		ticks = ticks - 1;
+		done  = load - SysTick->VAL;     // counts elapsed since the deadline
+		count = done < period ? period - done : 1;
+	}
+	else
+	if ((done = load - SysTick->VAL) < count)
+	{                                    // woken up in the current tick
+		ticks = 0;
+		count = count - done;
+	}
+	else
+	{                                    // woken up after some ticks
+		done  = done - count;
+		ticks = done / period + 1;
+		count = period - done % period;
+	}
+
+	SysTick->LOAD  = count > 1 ? count - 1 : 1; // finish the current tick
+	SysTick->VAL   = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD  = period - 1;         // restore the tick period
+
+	return ticks;
+}
+
+/******************************************************************************
+ End of the procedure
+*******************************************************************************/
+
+#endif//OS_TICK_SUPPRESS
+
 #else //HW_TIMER_SIZE
 
 /******************************************************************************
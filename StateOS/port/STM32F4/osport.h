@@ -126,6 +126,29 @@ void port_ctx_reset( void )
 #endif
 }
 
+/* -------------------------------------------------------------------------- */
+// stop the system timer (non-tick-less mode)
+
+__STATIC_INLINE
+void port_tck_suspend( void )
+{
+#if HW_TIMER_SIZE == 0
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+// restart the system timer with a full tick period (non-tick-less mode)
+
+__STATIC_INLINE
+void port_tck_resume( void )
+{
+#if HW_TIMER_SIZE == 0
+	SysTick->VAL   = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+
 /* -------------------------------------------------------------------------- */
 // clear time breakpoint
 
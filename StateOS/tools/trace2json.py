@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#******************************************************************************
+#
+#   @file    StateOS: trace2json.py
+#   @author  Rajmund Szymanski
+#   @date    13.06.2018
+#   @brief   Decoder of the StateOS kernel trace (OS_TRACE) to Chrome trace JSON.
+#
+#******************************************************************************
+#
+#   Usage:
+#     trace2json.py dump.bin [-n names.txt] [-o trace.json]
+#
+#   dump.bin  : memory dump of the 'Trace' object, e.g. from gdb:
+#               dump binary value dump.bin Trace
+#   names.txt : optional names of the objects, one 'address name' pair per line,
+#               the output of 'nm' (address type name) is also accepted
+#
+#   The output can be opened in chrome://tracing or https://ui.perfetto.dev
+#   Every task is shown as a thread; running time of the task, waits, wakeups,
+#   timer expirations and mutex ownership are shown on its track, wakeups are
+#   connected by flow arrows with the moment the woken task starts to run.
+#
+#******************************************************************************
+
+import argparse
+import json
+import struct
+import sys
+
+TRC_SWITCH = 1
+TRC_WAIT   = 2
+TRC_WAKEUP = 3
+TRC_TIMER  = 4
+TRC_LOCK   = 5
+TRC_UNLOCK = 6
+
+EVENTS = { 0x000000: 'E_SUCCESS', 0xFFFFFF: 'E_STOPPED', 0xFFFFFE: 'E_TIMEOUT' }
+
+TIMERS = 0 # track of the timer expirations
+
+def read_names( path ):
+	names = {}
+	if path:
+		with open(path) as f:
+			for line in f:
+				item = line.split()
+				if len(item) >= 2:
+					try:
+						names[int(item[0], 16) & 0xFFFFFFFF] = item[-1]
+					except ValueError:
+						pass
+	return names
+
+def read_trace( path ):
+	with open(path, 'rb') as f:
+		data = f.read()
+	magic, limit, count, freq = struct.unpack_from('<4sIII', data, 0)
+	if magic != b'STRC':
+		sys.exit('%s: not a StateOS trace dump' % path)
+	recs = [ struct.unpack_from('<IIII', data, 16 + i * 16) for i in range(limit) ]
+	if count > limit:
+		first = count % limit
+		recs = recs[first:] + recs[:first]
+	else:
+		recs = recs[:count]
+	return freq, recs, count
+
+def decode( freq, recs, names ):
+	def name( obj ):
+		return names.get(obj, '0x%08X' % obj)
+
+	out   = []
+	tasks = set()
+	run   = {}    # task -> start of the running interval (us)
+	flows = {}    # task -> id of the pending wakeup flow
+	cur   = None  # current task
+	time  = 0     # cycles
+	last  = None
+	ts    = 0.0   # us
+	flow  = 0
+
+	for stamp, kind, obj, arg in recs:
+		time += 0 if last is None else (stamp - last) & 0xFFFFFFFF
+		last  = stamp
+		ts    = time * 1e6 / freq
+		info  = kind >> 8
+		kind &= 0xFF
+
+		if kind == TRC_SWITCH:
+			tasks.update((obj, arg))
+			start = run.pop(arg, 0.0) # the first task runs from the beginning of the trace
+			out.append({ 'ph': 'X', 'name': 'run', 'pid': 1, 'tid': arg, 'ts': start, 'dur': ts - start })
+			run[obj] = ts
+			cur = obj
+			if obj in flows:
+				out.append({ 'ph': 'f', 'bp': 'e', 'name': 'wakeup', 'cat': 'wakeup', 'id': flows.pop(obj), 'pid': 1, 'tid': obj, 'ts': ts })
+		elif kind == TRC_WAIT:
+			tasks.add(obj)
+			out.append({ 'ph': 'i', 's': 't', 'name': 'wait ' + name(arg), 'pid': 1, 'tid': obj, 'ts': ts })
+		elif kind == TRC_WAKEUP:
+			tasks.add(obj)
+			event = EVENTS.get(info, str(info))
+			out.append({ 'ph': 'i', 's': 't', 'name': 'wakeup %s (%s)' % (name(arg), event), 'pid': 1, 'tid': obj, 'ts': ts })
+			flow += 1
+			flows[obj] = flow
+			out.append({ 'ph': 's', 'name': 'wakeup', 'cat': 'wakeup', 'id': flow, 'pid': 1, 'tid': cur if cur is not None else TIMERS, 'ts': ts })
+		elif kind == TRC_TIMER:
+			out.append({ 'ph': 'i', 's': 't', 'name': 'timer ' + name(obj), 'pid': 1, 'tid': TIMERS, 'ts': ts })
+		elif kind == TRC_LOCK:
+			tasks.add(arg)
+			out.append({ 'ph': 'b', 'name': name(obj), 'cat': 'mutex', 'id': obj, 'pid': 1, 'tid': arg, 'ts': ts })
+		elif kind == TRC_UNLOCK:
+			tasks.add(arg)
+			out.append({ 'ph': 'e', 'name': name(obj), 'cat': 'mutex', 'id': obj, 'pid': 1, 'tid': arg, 'ts': ts })
+
+	for tsk, start in run.items():
+		out.append({ 'ph': 'X', 'name': 'run', 'pid': 1, 'tid': tsk, 'ts': start, 'dur': ts - start })
+
+	out.append({ 'ph': 'M', 'name': 'process_name', 'pid': 1, 'args': { 'name': 'StateOS' } })
+	out.append({ 'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': TIMERS, 'args': { 'name': 'timers' } })
+	for tsk in tasks:
+		out.append({ 'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': tsk, 'args': { 'name': name(tsk) } })
+
+	return out
+
+def main():
+	parser = argparse.ArgumentParser(description = 'Convert the StateOS kernel trace dump to Chrome trace JSON.')
+	parser.add_argument('dump', help = 'memory dump of the Trace object')
+	parser.add_argument('-n', '--names', help = 'file with names of the objects (address name)')
+	parser.add_argument('-o', '--output', help = 'output file (default: stdout)')
+	args = parser.parse_args()
+
+	freq, recs, count = read_trace(args.dump)
+	if count > len(recs):
+		sys.stderr.write('%u records lost, the ring buffer holds the last %u\n' % (count - len(recs), len(recs)))
+
+	trace = { 'traceEvents': decode(freq, recs, read_names(args.names)), 'displayTimeUnit': 'ns' }
+
+	if args.output:
+		with open(args.output, 'w') as f:
+			json.dump(trace, f)
+	else:
+		json.dump(trace, sys.stdout)
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,44 @@
+#include <os.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// the host version of demo-1: the tasks toggle the emulated leds, the state of the leds is printed
+
+static unsigned LED[5];
+
+void proc()
+{
+	static   unsigned i = 0;
+	unsigned*led;
+	uint32_t timePoint;
+
+	led = &LED[i];
+	timePoint = SEC/8*i++;
+
+	for (;;)
+	{
+		tsk_sleepUntil(timePoint += SEC/2);
+		(*led)++;
+		printf("%u%u%u%u%u\n", LED[0] & 1, LED[1] & 1, LED[2] & 1, LED[3] & 1, LED[4] & 1);
+	}
+}
+
+// static stacks: TSK_CREATE expands _TSK_STACK twice, so stack and top would point to different arrays
+OS_TSK(led0, 0, proc);
+OS_TSK(led1, 0, proc);
+OS_TSK(led2, 0, proc);
+OS_TSK(led3, 0, proc);
+OS_TSK(led4, 0, proc);
+
+int main()
+{
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	tsk_start(led0);
+	tsk_start(led1);
+	tsk_start(led2);
+	tsk_start(led3);
+	tsk_start(led4);
+	tsk_sleepFor(SEC*3);
+	exit(0);
+}
@@ -67,6 +67,13 @@
 // default value: 0
 #define OS_HEAP_SIZE          0
 
+// ----------------------------
+// system heap allocator, used when OS_HEAP_SIZE > 0
+// OS_HEAP_TLSF == 0 => first-fit allocator with lazy merging of free memory segments, allocation time depends on fragmentation
+// OS_HEAP_TLSF == 1 => two-level segregated fit allocator with immediate merging, allocation and release take a constant time
+// default value: 0
+#define OS_HEAP_TLSF          0
+
 // ----------------------------
 // default task stack size in bytes
 // default value: 256
@@ -82,3 +89,101 @@
 // available values: 16, 32, 64
 // default value: 32
 #define OS_TIMER_SIZE        32
+
+// ----------------------------
+// organization of the timers' READY queue
+// OS_TIMER_WHEEL == 0 => timers are kept in a list sorted by their deadlines, insertion time depends on the number of running timers
+// OS_TIMER_WHEEL == 1 => timers are kept in a hierarchical timing wheel, insertion and removal take a constant time
+// default value: 0
+#define OS_TIMER_WHEEL        0
+
+// ----------------------------
+// number of task priority levels indexed by the bitmap of the tasks' READY queue
+// OS_PRIO_LEVELS == 0 => tasks' READY queue is a sorted list, task priority can be any unsigned int value
+// OS_PRIO_LEVELS >  0 => tasks' READY queue is indexed by the priority bitmap, task priority should be less then OS_PRIO_LEVELS,
+//                        higher priorities are treated as OS_PRIO_LEVELS-1
+// maximum value: 1024
+// default value: 0
+#define OS_PRIO_LEVELS        0
+
+// ----------------------------
+// priority of the timer service task
+// OS_TIMER_TASK == 0 => timers' callback procedures are launched in the system timer interrupt with the interrupts masked
+// OS_TIMER_TASK >  0 => expired timers are passed to the timer service task, which launches their callback procedures in the thread mode
+//                       with the interrupts enabled; timers marked with the function 'tmr_setISR' still launch their callbacks in the interrupt
+//                       (the timer service task takes OS_STACK_SIZE bytes of stack)
+// default value: 0
+#define OS_TIMER_TASK         0
+
+// ----------------------------
+// suppression of system timer interrupts in the idle task (non-tick-less mode only)
+// OS_TICK_SUPPRESS == 0 => system timer generates interrupts with frequency OS_FREQUENCY all the time
+// OS_TICK_SUPPRESS == 1 => idle task reprograms the system timer to the nearest timer deadline before going to sleep and corrects the system time on wakeup
+// default value: 0
+#define OS_TICK_SUPPRESS      0
+
+// ----------------------------
+// collection of tasks' run-time statistics (run time, context switches, preemptions and voluntary yields)
+// OS_TASK_STATS == 0 => statistics are not collected, the context switch does not have any additional cost
+// OS_TASK_STATS == 1 => statistics are collected at every context switch, run time is measured with the cycle counter (DWT CYCCNT, Cortex-M3 and later)
+// default value: 0
+#define OS_TASK_STATS         0
+
+// ----------------------------
+// layout of memory pool objects
+// OS_MEM_COMPACT == 0 => every memory object keeps the header of the list, so it can be transferred through the list object
+// OS_MEM_COMPACT == 1 => memory objects have no header, the link of the free memory object is stored in its own data
+// default value: 0
+#define OS_MEM_COMPACT        0
+
+// ----------------------------
+// indexing of tasks waiting for the flag object
+// OS_FLAG_INDEX == 0 => all waiting tasks are kept in a single queue, flg_give checks every waiting task
+// OS_FLAG_INDEX == 1 => tasks waiting for a single flag are kept in separate queues, one per flag, flg_give checks only the queues of the flags that are set
+//                       (the flag object takes 32 additional pointers)
+// default value: 0
+#define OS_FLAG_INDEX         0
+
+// ----------------------------
+// size of the kernel trace ring buffer (number of records)
+// OS_TRACE == 0 => kernel events are not recorded
+// OS_TRACE >  0 => context switches, task wakeups and waits, timer expirations and mutex locks are recorded in the ring buffer 'Trace'
+//                  (16 bytes per record, timestamps from the cycle counter), see StateOS/tools/trace2json.py
+// default value: 0
+#define OS_TRACE              0
+
+// ----------------------------
+// painting of tasks' stacks (stack high-water mark tracking)
+// OS_STACK_PAINT == 0 => stacks are painted only in the DEBUG mode, function 'tsk_stackUsage' is not available
+// OS_STACK_PAINT == 1 => stack of the task is painted every time the task is started, function 'tsk_stackUsage' returns the peak stack usage
+// default value: 0
+#define OS_STACK_PAINT        0
+
+// ----------------------------
+// period of the stack check in the idle task (in ticks), used when OS_STACK_PAINT is set
+// OS_STACK_CHECK == 0 => stacks are scanned only on request, function 'tsk_stackUsage' scans the stack of the task
+// OS_STACK_CHECK >  0 => idle task scans stacks of all tasks every OS_STACK_CHECK ticks, one task per run of the idle task,
+//                        and records their peak stack usage,
+//                        function 'tsk_stackUsage' scans only the part of the stack below the recorded value
+// default value: 0
+#define OS_STACK_CHECK        0
+
+// ----------------------------
+// size of the MPU guard region at the bottom of the current task's stack in bytes (Cortex-M port with MPU only)
+// OS_STACK_GUARD == 0 => stacks are not protected, stack overflow silently corrupts the memory below the stack
+// OS_STACK_GUARD >  0 => MPU region 7 forbids any access to OS_STACK_GUARD bytes (aligned to their size) at the bottom of the current task's stack,
+//                        so stack overflow raises MemManage fault at once; every context switch reprograms the region (two MPU register writes and a barrier)
+//                        OS_STACK_GUARD must be a power of 2 and at least 32, the usable task stack gets smaller by up to 2*OS_STACK_GUARD-1 bytes
+//                        the main task (system stack) and the idle task (OS_IDLE_STACK) are not protected
+// default value: 0
+#define OS_STACK_GUARD        0
+
+// ----------------------------
+// size of the stack shared by run-to-completion tasks in bytes (Stack Resource Policy)
+// OS_SRP_STACK == 0 => every task has its own stack
+// OS_SRP_STACK >  0 => tasks defined with OS_SRP / srp_init do not have private stacks, every start of such a task runs its state function
+//                      once on the shared stack, below the tasks it preempted; OS_SRP_STACK must hold the deepest chain of preemptions
+//                      a started run-to-completion task can not wait, suspend itself or lock a mutex with priority inheritance (mtx_*),
+//                      because it would resume on top of the tasks started after it; shared resources are guarded with srp_lock / srp_unlock
+// default value: 0
+#define OS_SRP_STACK          0